@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Micro-benchmarks for libcluon's Envelope and message codecs.
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Number of heap allocations, counted by the replaced global operators new. The whole
+// family is replaced so that every allocation is counted and released by the matching
+// function; the operators are not inlined, as GCC would otherwise pair the inlined
+// std::free with the call to operator new and warn about mismatched functions.
+std::atomic<uint64_t> allocations{0};
+
+namespace
+{
+void *allocate(std::size_t size) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc((0 < size) ? size : 1);
+}
+
+#ifdef __cpp_aligned_new
+void *allocate(std::size_t size, std::align_val_t alignment) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p{nullptr};
+    const std::size_t ALIGNMENT = std::max(static_cast<std::size_t>(alignment), sizeof(void *));
+    return (0 == posix_memalign(&p, ALIGNMENT, (0 < size) ? size : 1)) ? p : nullptr;
+}
+#endif
+} // namespace
+
+__attribute__((noinline)) void *operator new(std::size_t size)
+{
+    if (void *p = allocate(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size)
+{
+    if (void *p = allocate(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+#ifdef __cpp_aligned_new
+__attribute__((noinline)) void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *p = allocate(size, alignment))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void *p = allocate(size, alignment))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate(size, alignment);
+}
+
+__attribute__((noinline)) void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate(size, alignment);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+#endif
+
+struct Result
+{
+    std::string codec;
+    double medianNs;
+    double minNs;
+    double allocations;
+};
+
+/**
+ * Time the given codec: each repetition runs it a number of iterations and
+ * reports the mean per iteration.
+ */
+Result measure(const std::string &codec, uint32_t repetitions, uint32_t iterations, const std::function<void()> &run)
+{
+    std::vector<double> means;
+    const uint64_t ALLOCATIONS = allocations.load();
+    for (uint32_t r = 0; r < repetitions; r++)
+    {
+        const auto before = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            run();
+        }
+        const auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before);
+        means.push_back(static_cast<double>(total.count()) / iterations);
+    }
+    const double ALLOCATIONS_PER_ITERATION = static_cast<double>(allocations.load() - ALLOCATIONS) / repetitions / iterations;
+    std::sort(means.begin(), means.end());
+    return Result{codec, means[means.size() / 2], means.front(), ALLOCATIONS_PER_ITERATION};
+}
+
+void print(const Result &r, const std::string &unit, double unitsPerIteration)
+{
+    const double RATE = (r.medianNs > 0) ? unitsPerIteration / r.medianNs * 1e9 : 0;
+    std::cout << std::setw(36) << r.codec << std::fixed << std::setprecision(1) << std::setw(14) << r.medianNs << std::setw(14) << r.minNs
+              << std::setw(10) << r.allocations << std::setprecision(0) << std::setw(16) << RATE << " " << unit << "/s" << std::endl;
+}
+
+/**
+ * @return OD4-framed Envelope carrying the given message.
+ */
+template <typename T>
+std::string envelopeWith(T &msg, uint32_t senderStamp)
+{
+    cluon::ToProtoVisitor protoEncoder;
+    msg.accept(protoEncoder);
+
+    cluon::data::Envelope envelope;
+    envelope.dataType(static_cast<int32_t>(T::ID()));
+    envelope.serializedData(protoEncoder.encodedData());
+    envelope.sent(cluon::time::now());
+    envelope.sampleTimeStamp(envelope.sent());
+    envelope.senderStamp(senderStamp);
+    return cluon::serializeEnvelope(std::move(envelope));
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 != commandlineArguments.count("help"))
+    {
+        std::cerr << argv[0] << " benchmarks libcluon's Envelope and message codecs." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " [--repetitions=<n>] [--iterations=<n>] [--rec=<file>]" << std::endl;
+        std::cerr << "         --repetitions: number of measurements per codec (default: 10)" << std::endl;
+        std::cerr << "         --iterations:  number of messages per measurement (default: 100000)" << std::endl;
+        std::cerr << "         --rec:         recording to decode in addition to synthetic Envelopes" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --rec=CID-253-recording.rec" << std::endl;
+        return 1;
+    }
+
+    const uint32_t REPETITIONS{(commandlineArguments.count("repetitions") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["repetitions"])) : 10};
+    const uint32_t ITERATIONS{(commandlineArguments.count("iterations") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["iterations"])) : 100000};
+
+    opendlv::proxy::GroundSteeringRequest gsr;
+    gsr.groundSteering(0.123f);
+    const std::string DATAGRAM{envelopeWith(gsr, 17)};
+
+    std::cout << std::setw(36) << "codec" << std::setw(14) << "median ns" << std::setw(14) << "min ns" << std::setw(10) << "allocs" << std::setw(16) << "rate"
+              << std::endl;
+
+    // Keeps the compiler from optimizing the decoding away
+    volatile float sink{0};
+
+    // Decoding an Envelope with a GroundSteeringRequest as received by OD4Session
+    print(measure("decode istream", REPETITIONS, ITERATIONS, [&]() {
+              std::stringstream sstr(DATAGRAM);
+              auto env = cluon::extractEnvelope(sstr);
+              std::stringstream payload(env.second.serializedData());
+              cluon::FromProtoVisitor decoder;
+              decoder.decodeFrom(payload);
+              opendlv::proxy::GroundSteeringRequest msg;
+              msg.accept(decoder);
+              sink += msg.groundSteering();
+          }),
+          "msg", 1);
+    print(measure("decode in place", REPETITIONS, ITERATIONS, [&]() {
+              auto env = cluon::extractEnvelope(DATAGRAM.data(), DATAGRAM.size());
+              auto msg = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env.second));
+              sink += msg.groundSteering();
+          }),
+          "msg", 1);
+
+    // Decoding through the map of fields against assigning the fields directly
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    const char *ENVELOPE{DATAGRAM.data() + OD4_HEADER_SIZE};
+    const std::size_t ENVELOPE_SIZE{DATAGRAM.size() - OD4_HEADER_SIZE};
+    print(measure("Envelope via field map", REPETITIONS, ITERATIONS, [&]() {
+              cluon::FromProtoVisitor decoder;
+              decoder.decodeFrom(ENVELOPE, ENVELOPE_SIZE);
+              cluon::data::Envelope env;
+              env.accept(decoder);
+              sink += static_cast<float>(env.senderStamp());
+          }),
+          "msg", 1);
+    print(measure("Envelope direct", REPETITIONS, ITERATIONS, [&]() {
+              cluon::FromProtoVisitor decoder;
+              cluon::data::Envelope env;
+              decoder.decodeFrom(ENVELOPE, ENVELOPE_SIZE, env);
+              sink += static_cast<float>(env.senderStamp());
+          }),
+          "msg", 1);
+    const std::string PAYLOAD{cluon::extractEnvelope(DATAGRAM.data(), DATAGRAM.size()).second.serializedData()};
+    print(measure("GroundSteeringRequest via field map", REPETITIONS, ITERATIONS, [&]() {
+              cluon::FromProtoVisitor decoder;
+              decoder.decodeFrom(PAYLOAD.data(), PAYLOAD.size());
+              opendlv::proxy::GroundSteeringRequest msg;
+              msg.accept(decoder);
+              sink += msg.groundSteering();
+          }),
+          "msg", 1);
+    print(measure("GroundSteeringRequest direct", REPETITIONS, ITERATIONS, [&]() {
+              cluon::FromProtoVisitor decoder;
+              opendlv::proxy::GroundSteeringRequest msg;
+              decoder.decodeFrom(PAYLOAD.data(), PAYLOAD.size(), msg);
+              sink += msg.groundSteering();
+          }),
+          "msg", 1);
+
+    // Reading two fields of a large message: decoding it completely against a view
+    opendlv::proxy::ImageReading image;
+    image.fourcc("h264").width(1280).height(720).data(std::string(1024 * 1024, 'x'));
+    const std::string IMAGE{envelopeWith(image, 0)};
+    print(measure("ImageReading 1 MB decode", REPETITIONS, ITERATIONS / 100, [&]() {
+              auto env = cluon::extractEnvelope(IMAGE.data(), IMAGE.size());
+              auto msg = cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(env.second));
+              sink += static_cast<float>(msg.width() * msg.height());
+          }),
+          "msg", 1);
+    print(measure("ImageReading 1 MB view", REPETITIONS, ITERATIONS / 100, [&]() {
+              auto payload = cluon::peekEnvelopeSerializedData(IMAGE.data(), IMAGE.size());
+              opendlv::proxy::ImageReadingView view{payload.first, payload.second};
+              sink += static_cast<float>(view.width() * view.height());
+          }),
+          "msg", 1);
+
+    // Encoding an Envelope with a GroundSteeringRequest as sent by OD4Session
+    const cluon::data::TimeStamp NOW{cluon::time::now()};
+    print(measure("encode via Envelope", REPETITIONS, ITERATIONS, [&]() {
+              cluon::ToProtoVisitor protoEncoder;
+              gsr.accept(protoEncoder);
+              cluon::data::Envelope envelope;
+              envelope.dataType(opendlv::proxy::GroundSteeringRequest::ID());
+              envelope.serializedData(protoEncoder.encodedData());
+              envelope.sent(NOW);
+              envelope.sampleTimeStamp(NOW);
+              envelope.senderStamp(17);
+              const std::string DATA{cluon::serializeEnvelope(std::move(envelope))};
+              sink += static_cast<float>(DATA.size());
+          }),
+          "msg", 1);
+    std::string buffer;
+    print(measure("encode in place", REPETITIONS, ITERATIONS, [&]() {
+              cluon::serializeEnvelope(buffer, gsr, NOW, NOW, 17);
+              sink += static_cast<float>(buffer.size());
+          }),
+          "msg", 1);
+    {
+        // Complete send path including the system call; nobody needs to receive
+        cluon::OD4Session od4{254};
+        print(measure("OD4Session::send", REPETITIONS, ITERATIONS / 10, [&]() { od4.send(gsr, NOW, 17); }), "msg", 1);
+    }
+
+    // Walking through a recording in memory: synthetic or mmap'ed from a file
+    std::string synthetic;
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        gsr.groundSteering(static_cast<float>(i) * 1e-4f);
+        synthetic += envelopeWith(gsr, i);
+    }
+    const char *recording{synthetic.data()};
+    std::size_t recordingSize{synthetic.size()};
+    void *mapped{MAP_FAILED};
+    if (commandlineArguments.count("rec") != 0)
+    {
+        const int fd = ::open(commandlineArguments["rec"].c_str(), O_RDONLY);
+        struct stat st;
+        if ((0 <= fd) && (0 == ::fstat(fd, &st)) && (0 < st.st_size))
+        {
+            mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != mapped)
+            {
+                recording = static_cast<const char *>(mapped);
+                recordingSize = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        if (0 <= fd)
+        {
+            ::close(fd);
+        }
+        if (MAP_FAILED == mapped)
+        {
+            std::cerr << argv[0] << ": Could not map " << commandlineArguments["rec"] << "." << std::endl;
+            return 1;
+        }
+    }
+
+    uint64_t envelopes{0};
+    {
+        const char *pos{recording};
+        std::size_t remaining{recordingSize};
+        std::pair<std::size_t, cluon::data::Envelope> env;
+        while (0 < (env = cluon::extractEnvelope(pos, remaining)).first)
+        {
+            pos += env.first;
+            remaining -= env.first;
+            envelopes++;
+        }
+    }
+    const uint32_t PASSES{std::max<uint32_t>(1, REPETITIONS / 2)};
+    print(measure("recording istream", REPETITIONS, PASSES, [&]() {
+              std::stringstream sstr(std::string(recording, recordingSize));
+              while (sstr.good())
+              {
+                  auto env = cluon::extractEnvelope(sstr);
+                  sink += static_cast<float>(env.second.senderStamp());
+              }
+          }),
+          "envelopes", static_cast<double>(envelopes));
+    print(measure("recording in place", REPETITIONS, PASSES, [&]() {
+              const char *pos{recording};
+              std::size_t remaining{recordingSize};
+              std::pair<std::size_t, cluon::data::Envelope> env;
+              while (0 < (env = cluon::extractEnvelope(pos, remaining)).first)
+              {
+                  pos += env.first;
+                  remaining -= env.first;
+                  sink += static_cast<float>(env.second.senderStamp());
+              }
+          }),
+          "envelopes", static_cast<double>(envelopes));
+    std::cout << "(" << envelopes << " envelopes, " << recordingSize << " bytes per pass)" << std::endl;
+
+    if (MAP_FAILED != mapped)
+    {
+        ::munmap(mapped, recordingSize);
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Load test for libcluon's UDP transport as used by OD4Session: bursts of
+// datagrams are sent to the session's multicast group and received by a
+// cluon::UDPReceiver in the same process. With --envelopes, bursts of
+// GroundSteeringRequests are sent from one OD4Session to another instead,
+// optionally decoded by a pool of workers in the receiving OD4Session.
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+#include "latency-histogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Waits until the receiver has not received anything for 200 ms.
+static void waitUntilDrained(const std::atomic<uint64_t> &received)
+{
+    uint64_t last{0};
+    do
+    {
+        last = received.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } while (last != received.load());
+}
+
+static void printLatency(const LatencyHistogram &latency)
+{
+    std::cout << "Latency [us]:     p50 " << latency.percentile(50) / 1e3 << " p90 " << latency.percentile(90) / 1e3 << " p99 "
+              << latency.percentile(99) / 1e3 << " p99.9 " << latency.percentile(99.9) / 1e3 << " max " << latency.max() / 1e3 << std::endl;
+}
+
+// Sends GroundSteeringRequests from one OD4Session to another one, optionally
+// queued per burst (batch) and packed into datagrams of up to pack bytes. The
+// Envelopes are spread round robin over streams senderStamps; each carries its
+// sequence number within its stream to check that every stream arrives in order.
+static int32_t runEnvelopes(uint16_t cid, uint32_t messages, uint32_t burst, uint32_t pause, bool batch, uint32_t pack, uint32_t work, uint32_t workers, uint32_t streams)
+{
+    // Latency from sending an Envelope until its delegate is called; Envelopes carry the sent time stamp in microseconds
+    std::mutex latencyMutex;
+    LatencyHistogram latency;
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> outOfOrder{0};
+    // Written by the one worker dispatching the stream
+    std::vector<int64_t> lastSequence(streams, -1);
+
+    cluon::OD4Session receiver{cid};
+    receiver.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), [&](cluon::data::Envelope &&envelope) {
+        const int64_t now = cluon::time::toMicroseconds(cluon::time::now());
+        {
+            std::lock_guard<std::mutex> lck(latencyMutex);
+            latency.record(static_cast<uint64_t>(std::max<int64_t>(0, now - cluon::time::toMicroseconds(envelope.sent())) * 1000));
+        }
+        const uint32_t stream = envelope.senderStamp() % streams;
+        const auto sequence = static_cast<int64_t>(cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(envelope)).groundSteering());
+        if (sequence <= lastSequence[stream])
+        {
+            outOfOrder.fetch_add(1);
+        }
+        lastSequence[stream] = sequence;
+        if (0 < work)
+        {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(work);
+            while (std::chrono::steady_clock::now() < until)
+            {
+            }
+        }
+        received.fetch_add(1);
+    });
+    if (0 < workers)
+    {
+        receiver.decodeWorkers(workers);
+    }
+    cluon::OD4Session sender{cid};
+    if (!receiver.isRunning())
+    {
+        std::cerr << "bench-udp: Failed to join OD4 session " << cid << "." << std::endl;
+        return 1;
+    }
+    sender.batchSends(batch || (0 < pack), false);
+    sender.packEnvelopes(pack);
+
+    opendlv::proxy::GroundSteeringRequest request;
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t sent{0};
+    while (sent < messages)
+    {
+        for (uint32_t i = 0; (i < burst) && (sent < messages); i++, sent++)
+        {
+            request.groundSteering(static_cast<float>(sent / streams));
+            sender.send(request, cluon::data::TimeStamp(), sent % streams);
+        }
+        sender.flush();
+        std::this_thread::sleep_for(std::chrono::microseconds(pause));
+    }
+    const double SEND_SECONDS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    waitUntilDrained(received);
+
+    const double RECEIVE_SECONDS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint64_t ENVELOPES = sender.numberOfSentEnvelopes();
+    const uint64_t DATAGRAMS = sender.numberOfSentDatagrams();
+    const uint64_t SEND_CALLS = sender.numberOfSendCalls();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Sent:             " << ENVELOPES << " Envelopes in " << DATAGRAMS << " datagrams ("
+              << ((DATAGRAMS > 0) ? static_cast<double>(ENVELOPES) / DATAGRAMS : 0) << " Envelopes/datagram) in " << SEND_SECONDS << " s" << std::endl;
+    std::cout << "Send calls:       " << SEND_CALLS << " (" << ((SEND_CALLS > 0) ? static_cast<double>(DATAGRAMS) / SEND_CALLS : 0) << " datagrams/syscall)" << std::endl;
+    std::cout << "Received:         " << received.load() << " (" << (sent - std::min<uint64_t>(sent, received.load())) << " lost, "
+              << outOfOrder.load() << " out of order)" << std::endl;
+    const auto statistics = receiver.decodeWorkerStatistics();
+    for (std::size_t i = 0; i < statistics.size(); i++)
+    {
+        const auto &worker = statistics[i];
+        std::cout << "Worker " << std::setw(2) << i << ":        " << worker.m_numberOfDispatchedEnvelopes << " Envelopes ("
+                  << worker.m_numberOfDispatchedEnvelopes / RECEIVE_SECONDS << "/s, "
+                  << ((worker.m_busyTimeInNanoseconds > 0) ? worker.m_numberOfDispatchedEnvelopes * 1e9 / worker.m_busyTimeInNanoseconds : 0)
+                  << "/s busy), " << worker.m_numberOfDroppedEnvelopes << " dropped, queue high-water mark " << worker.m_queueHighWaterMark << std::endl;
+    }
+    std::lock_guard<std::mutex> lck(latencyMutex);
+    printLatency(latency);
+    return 0;
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 != commandlineArguments.count("help"))
+    {
+        std::cerr << argv[0] << " measures the throughput of libcluon's UDP multicast transport." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " [--cid=<n>] [--messages=<n>] [--size=<bytes>] [--burst=<n>] [--pause=<us>] [--work=<us>] [--batch] [--envelopes [--pack=<bytes>] [--workers=<n>] [--streams=<n>]]" << std::endl;
+        std::cerr << "         --cid:       OD4 session to send to, i.e., multicast group 225.0.0.<cid> (default: 111)" << std::endl;
+        std::cerr << "         --messages:  number of datagrams to send (default: 100000)" << std::endl;
+        std::cerr << "         --size:      size of a datagram in bytes (default: 128)" << std::endl;
+        std::cerr << "         --burst:     number of datagrams sent back to back (default: 64)" << std::endl;
+        std::cerr << "         --pause:     pause between bursts in microseconds (default: 1000)" << std::endl;
+        std::cerr << "         --work:      time the delegate spends per datagram in microseconds to simulate a slow consumer (default: 0)" << std::endl;
+        std::cerr << "         --batch:     queue the datagrams of a burst and send them together (sendmmsg on Linux)" << std::endl;
+        std::cerr << "         --envelopes: send GroundSteeringRequests from one OD4Session to another instead of raw datagrams" << std::endl;
+        std::cerr << "         --pack:      pack the Envelopes of a burst into datagrams of up to the given size (e.g. 1472)" << std::endl;
+        std::cerr << "         --workers:   decode and dispatch the Envelopes in a pool of the given number of threads (default: 0)" << std::endl;
+        std::cerr << "         --streams:   number of senderStamps to spread the Envelopes over (default: 1)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --messages=200000 --size=64 --burst=128" << std::endl;
+        return 1;
+    }
+
+    const uint16_t CID{static_cast<uint16_t>((commandlineArguments.count("cid") != 0) ? std::stoi(commandlineArguments["cid"]) : 111)};
+    const uint32_t MESSAGES{(commandlineArguments.count("messages") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["messages"])) : 100000};
+    const uint32_t SIZE{std::max<uint32_t>(sizeof(int64_t), (commandlineArguments.count("size") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["size"])) : 128)};
+    const uint32_t BURST{std::max<uint32_t>(1, (commandlineArguments.count("burst") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["burst"])) : 64)};
+    const uint32_t PAUSE{(commandlineArguments.count("pause") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["pause"])) : 1000};
+    const uint32_t WORK{(commandlineArguments.count("work") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["work"])) : 0};
+    const bool BATCH{0 != commandlineArguments.count("batch")};
+    const uint32_t PACK{(commandlineArguments.count("pack") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["pack"])) : 0};
+    const uint32_t WORKERS{(commandlineArguments.count("workers") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["workers"])) : 0};
+    const uint32_t STREAMS{std::max<uint32_t>(1, (commandlineArguments.count("streams") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["streams"])) : 1)};
+    const std::string ADDRESS{"225.0.0." + std::to_string(CID)};
+
+    if (0 != commandlineArguments.count("envelopes"))
+    {
+        return runEnvelopes(CID, MESSAGES, BURST, PAUSE, BATCH, PACK, WORK, WORKERS, STREAMS);
+    }
+
+    // Latency from handing a datagram to the sender until the delegate is called
+    std::mutex latencyMutex;
+    LatencyHistogram latency;
+    std::atomic<uint64_t> received{0};
+
+    // A slow delegate should see the most recent datagrams; thus, the oldest waiting ones are discarded.
+    cluon::UDPReceiver receiver(ADDRESS, 12175, [&](const cluon::UDPDatagram &datagram) {
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t sent{0};
+        std::memcpy(&sent, datagram.data(), sizeof(sent));
+        {
+            std::lock_guard<std::mutex> lck(latencyMutex);
+            latency.record(static_cast<uint64_t>(std::max<int64_t>(0, now - sent)));
+        }
+        received.fetch_add(1);
+        if (0 < WORK)
+        {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(WORK);
+            while (std::chrono::steady_clock::now() < until)
+            {
+            }
+        }
+    }, 0, 1024, cluon::OverflowPolicy::DROP_OLDEST);
+    cluon::UDPSender sender(ADDRESS, 12175);
+    if (!receiver.isRunning())
+    {
+        std::cerr << argv[0] << ": Failed to receive from " << ADDRESS << ":12175." << std::endl;
+        return 1;
+    }
+
+    std::string payload(SIZE, 'x');
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t sent{0};
+    while (sent < MESSAGES)
+    {
+        for (uint32_t i = 0; (i < BURST) && (sent < MESSAGES); i++, sent++)
+        {
+            const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::memcpy(&payload[0], &now, sizeof(now));
+            if (BATCH)
+            {
+                sender.queue(payload.data(), payload.size());
+            }
+            else
+            {
+                sender.send(payload.data(), payload.size());
+            }
+        }
+        sender.flush();
+        std::this_thread::sleep_for(std::chrono::microseconds(PAUSE));
+    }
+    const double SEND_SECONDS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Give the receiver time to drain its socket and pipeline
+    waitUntilDrained(received);
+
+    const uint64_t PACKETS = receiver.numberOfReceivedPackets();
+    const uint64_t CALLS = receiver.numberOfReceiveCalls();
+    const uint64_t SENT_PACKETS = sender.numberOfSentPackets();
+    const uint64_t SEND_CALLS = sender.numberOfSendCalls();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Sent:             " << sent << " datagrams of " << SIZE << " bytes in " << SEND_SECONDS << " s ("
+              << sent / SEND_SECONDS << " datagrams/s)" << std::endl;
+    std::cout << "Send calls:       " << SEND_CALLS << " (" << ((SEND_CALLS > 0) ? static_cast<double>(SENT_PACKETS) / SEND_CALLS : 0) << " packets/syscall)" << std::endl;
+    std::cout << "Received:         " << received.load() << " (" << (sent - std::min<uint64_t>(sent, received.load())) << " lost)" << std::endl;
+    std::cout << "Dropped:          " << receiver.numberOfDroppedPackets() << " (queue high-water mark " << receiver.queueHighWaterMark() << ")" << std::endl;
+    std::cout << "Receive calls:    " << CALLS << " (" << ((CALLS > 0) ? static_cast<double>(PACKETS) / CALLS : 0) << " packets/syscall)" << std::endl;
+    std::lock_guard<std::mutex> lck(latencyMutex);
+    printLatency(latency);
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Micro-benchmarks for the vision kernels of the detector on synthetic frames.
+
+#include "cluon-complete.hpp"
+#include "cone-detector.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// BGR colours that fall into the detector's HSV ranges for blue and yellow cones
+const cv::Scalar BLUE_CONE(70, 32, 32, 255);
+const cv::Scalar YELLOW_CONE(74, 162, 180, 255);
+
+/**
+ * Create a reproducible BGRA frame (as found in the shared memory) with a
+ * noisy grey background and the given number of blue and yellow cones.
+ */
+cv::Mat syntheticFrame(int width, int height, int cones, uint64_t seed)
+{
+    cv::RNG rng(seed);
+    cv::Mat frame(height, width, CV_8UC4);
+    cv::randu(frame, cv::Scalar(60, 60, 60, 255), cv::Scalar(140, 140, 140, 255));
+
+    for (int i = 0; i < cones; i++)
+    {
+        // Cones on the ground, i.e., below the horizon; blue on the left, yellow on the right
+        const bool blue = (0 == i % 2);
+        const int x = blue ? rng.uniform(0, width / 2) : rng.uniform(width / 2, width);
+        const int y = rng.uniform(height / 2, height);
+        const int size = rng.uniform(height / 40 + 2, height / 12 + 3);
+        cv::ellipse(frame, cv::Point(x, y), cv::Size(size / 2, size), 0, 0, 360, blue ? BLUE_CONE : YELLOW_CONE, CV_FILLED, 8, 0);
+    }
+    return frame;
+}
+
+struct Result
+{
+    std::string stage;
+    double medianNs;
+    double minNs;
+    double stddevNs;
+};
+
+/**
+ * Time the given stage: each repetition runs the stage a number of iterations
+ * and reports the mean per iteration; prepare is run before each iteration
+ * outside of the timed region to restore the stage's input.
+ */
+Result measure(const std::string &stage, uint32_t repetitions, uint32_t iterations, const std::function<void()> &prepare, const std::function<void()> &run)
+{
+    std::vector<double> means;
+    for (uint32_t r = 0; r < repetitions; r++)
+    {
+        std::chrono::nanoseconds total{0};
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            prepare();
+            const auto before = std::chrono::steady_clock::now();
+            run();
+            total += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before);
+        }
+        means.push_back(static_cast<double>(total.count()) / iterations);
+    }
+
+    std::sort(means.begin(), means.end());
+    double sum = 0;
+    for (double m : means)
+    {
+        sum += m;
+    }
+    const double mean = sum / static_cast<double>(means.size());
+    double variance = 0;
+    for (double m : means)
+    {
+        variance += (m - mean) * (m - mean);
+    }
+    variance /= static_cast<double>(means.size());
+
+    return Result{stage, means[means.size() / 2], means.front(), std::sqrt(variance)};
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 != commandlineArguments.count("help"))
+    {
+        std::cerr << argv[0] << " benchmarks the vision kernels of the detector on synthetic frames." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " [--repetitions=<n>] [--iterations=<n>] [--threads=<n>] [--csv=<file>]" << std::endl;
+        std::cerr << "         --repetitions: number of measurements per stage (default: 10)" << std::endl;
+        std::cerr << "         --iterations:  number of frames per measurement (default: 50)" << std::endl;
+        std::cerr << "         --threads:     number of threads used by OpenCV (default: OpenCV's choice)" << std::endl;
+        std::cerr << "         --csv:         file to write the results to" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --repetitions=20 --threads=1 --csv=bench-vision.csv" << std::endl;
+        return 1;
+    }
+
+    const uint32_t REPETITIONS{(commandlineArguments.count("repetitions") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["repetitions"])) : 10};
+    const uint32_t ITERATIONS{(commandlineArguments.count("iterations") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["iterations"])) : 50};
+    if (commandlineArguments.count("threads") != 0)
+    {
+        cv::setNumThreads(std::stoi(commandlineArguments["threads"]));
+    }
+
+    std::ofstream csv;
+    if (commandlineArguments.count("csv") != 0)
+    {
+        csv.open(commandlineArguments["csv"]);
+        csv << "width,height,cones,stage,median_ns,min_ns,stddev_ns,mpixel_per_s\n";
+    }
+
+    const std::vector<cv::Size> RESOLUTIONS{cv::Size(640, 480), cv::Size(1280, 720), cv::Size(1920, 1080)};
+    const std::vector<int> DENSITIES{0, 4, 16, 64};
+
+    std::cout << std::setw(10) << "frame" << std::setw(7) << "cones" << std::setw(16) << "stage" << std::setw(14) << "median ns"
+              << std::setw(14) << "min ns" << std::setw(12) << "stddev %" << std::setw(12) << "Mpixel/s" << std::endl;
+
+    for (const cv::Size &resolution : RESOLUTIONS)
+    {
+        for (int cones : DENSITIES)
+        {
+            const cv::Mat original = syntheticFrame(resolution.width, resolution.height, cones, 17);
+            cv::Mat img = original.clone();
+            ConeDetector detector;
+            cv::Mat crop = detector.crop(img);
+            detector.detect(img);
+
+            // Throughput is relative to the pixels in the region of interest
+            const double PIXELS = static_cast<double>(crop.cols) * crop.rows;
+            cv::Mat yellow, blue;
+            auto nothing = []() {};
+            auto restoreThresholds = [&]() {
+                yellow.copyTo(detector.yellowThreshold());
+                blue.copyTo(detector.blueThreshold());
+            };
+
+            std::vector<Result> results;
+            results.push_back(measure("copy", REPETITIONS, ITERATIONS, nothing, [&]() { img = original.clone(); }));
+            results.push_back(measure("crop", REPETITIONS, ITERATIONS, nothing, [&]() { crop = detector.crop(img); }));
+            results.push_back(measure("cvt_color", REPETITIONS, ITERATIONS, nothing, [&]() { detector.convert(crop); }));
+            results.push_back(measure("in_range", REPETITIONS, ITERATIONS, nothing, [&]() { detector.threshold(); }));
+            detector.yellowThreshold().copyTo(yellow);
+            detector.blueThreshold().copyTo(blue);
+            results.push_back(measure("morphology", REPETITIONS, ITERATIONS, restoreThresholds, [&]() { detector.close(); }));
+            results.push_back(measure("count_non_zero", REPETITIONS, ITERATIONS, nothing, [&]() { detector.count(); }));
+            results.push_back(measure("moments", REPETITIONS, ITERATIONS, nothing, [&]() { detector.locate(); }));
+            results.push_back(measure("frame", REPETITIONS, ITERATIONS, nothing, [&]() {
+                img = original.clone();
+                detector.detect(img);
+            }));
+
+            for (const Result &r : results)
+            {
+                const double MPIXEL_PER_S = (r.medianNs > 0) ? PIXELS / r.medianNs * 1000.0 : 0;
+                std::cout << std::setw(10) << (std::to_string(resolution.width) + "x" + std::to_string(resolution.height)) << std::setw(7) << cones
+                          << std::setw(16) << r.stage << std::fixed << std::setprecision(0) << std::setw(14) << r.medianNs << std::setw(14) << r.minNs
+                          << std::setprecision(1) << std::setw(12) << ((r.medianNs > 0) ? 100.0 * r.stddevNs / r.medianNs : 0)
+                          << std::setw(12) << MPIXEL_PER_S << std::endl;
+                if (csv.is_open())
+                {
+                    csv << resolution.width << "," << resolution.height << "," << cones << "," << r.stage << "," << r.medianNs << ","
+                        << r.minNs << "," << r.stddevNs << "," << MPIXEL_PER_S << "\n";
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -6083,6 +6083,193 @@ class LIBCLUON_API TerminateHandler {
 };
 } // namespace cluon
 
+#endif
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_TRACER_HPP
+#define CLUON_TRACER_HPP
+
+//#include "cluon/cluon.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cluon {
+/**
+The Tracer records spans (name, category, begin, end) into per-thread buffers
+and writes them as Chrome trace JSON to be inspected in chrome://tracing or
+https://ui.perfetto.dev. Tracing is disabled by default; a span on a disabled
+tracer costs one relaxed atomic load. Recording is lock-free: each thread
+appends to its own buffer that is only read when writing the trace; spans
+beyond a buffer's capacity are dropped and counted.
+
+libcluon records the spans "UDPReceiver::receive", "UDPReceiver::dispatch",
+"OD4Session::decode" and "OD4Session::dispatch" in the category "cluon".
+
+\code{.cpp}
+cluon::Tracer::instance().enable();
+{
+    cluon::TraceSpan span("process", "app"); // Name and category must be string literals.
+    // Do something.
+}
+cluon::Tracer::instance().writeChromeTrace("trace.json");
+\endcode
+*/
+class LIBCLUON_API Tracer {
+   private:
+    Tracer(const Tracer &) = delete;
+    Tracer(Tracer &&)      = delete;
+    Tracer &operator=(const Tracer &) = delete;
+    Tracer &operator=(Tracer &&) = delete;
+
+   public:
+    /**
+     * Define singleton behavior using static initializer (cf. http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2011/n3242.pdf, Sec. 6.7.4).
+     * @return singleton for an instance of this class.
+     */
+    static Tracer &instance() noexcept {
+        static Tracer instance;
+        return instance;
+    }
+
+    ~Tracer() = default;
+
+   public:
+    /**
+     * This method starts recording spans.
+     *
+     * @param eventsPerThread Capacity of the buffer that is allocated for each recording thread on its first span.
+     */
+    void enable(uint32_t eventsPerThread = 262144) noexcept;
+
+    /**
+     * This method stops recording spans; recorded spans are kept.
+     */
+    void disable() noexcept;
+
+    /**
+     * @return true if spans are recorded.
+     */
+    inline bool isEnabled() const noexcept {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * This method records a span for the calling thread.
+     *
+     * @param name Name of the span; must outlive the tracer (e.g. a string literal).
+     * @param category Category of the span; must outlive the tracer (e.g. a string literal).
+     * @param begin Time point when the span began.
+     * @param end Time point when the span ended.
+     */
+    void record(const char *name, const char *category, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) noexcept;
+
+    /**
+     * This method names the calling thread in the trace.
+     *
+     * @param name Name of the thread; must outlive the tracer (e.g. a string literal).
+     */
+    void setThreadName(const char *name) noexcept;
+
+    /**
+     * @return Number of spans that did not fit into their thread's buffer.
+     */
+    uint64_t droppedEvents() const noexcept;
+
+    /**
+     * This method writes all spans recorded so far as Chrome trace JSON;
+     * it can be called while other threads are still recording.
+     *
+     * @param out Stream to write to.
+     */
+    void writeChromeTrace(std::ostream &out) const noexcept;
+
+    /**
+     * @param fileName File to write the Chrome trace JSON to.
+     * @return true if the file could be written.
+     */
+    bool writeChromeTrace(const std::string &fileName) const noexcept;
+
+   private:
+    Tracer() noexcept;
+
+    class Event {
+       public:
+        const char *m_name;
+        const char *m_category;
+        int64_t m_begin; // Nanoseconds since the tracer was created.
+        int64_t m_end;
+    };
+
+    class ThreadBuffer {
+       public:
+        uint32_t m_threadId{0};
+        const char *m_threadName{nullptr};
+        uint32_t m_capacity{0};
+        std::unique_ptr<Event[]> m_events{};
+        std::atomic<uint32_t> m_size{0};
+        std::atomic<uint64_t> m_dropped{0};
+    };
+
+    /**
+     * @return Buffer of the calling thread, created and registered on first use.
+     */
+    ThreadBuffer *threadBuffer() noexcept;
+
+    static const char *&threadName() noexcept;
+
+   private:
+    std::atomic<bool> m_enabled{false};
+    std::atomic<uint32_t> m_eventsPerThread{0};
+    const std::chrono::steady_clock::time_point m_epoch;
+
+    mutable std::mutex m_threadBuffersMutex{};
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers{};
+};
+
+/**
+Records a span from its construction to its destruction if the Tracer is enabled.
+*/
+class LIBCLUON_API TraceSpan {
+   private:
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan(TraceSpan &&)      = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+    TraceSpan &operator=(TraceSpan &&) = delete;
+
+   public:
+    TraceSpan(const char *name, const char *category) noexcept
+        : m_name(name)
+        , m_category(category)
+        , m_isRecording(Tracer::instance().isEnabled())
+        , m_begin(m_isRecording ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) {}
+
+    ~TraceSpan() noexcept {
+        if (m_isRecording) {
+            Tracer::instance().record(m_name, m_category, m_begin, std::chrono::steady_clock::now());
+        }
+    }
+
+   private:
+    const char *m_name;
+    const char *m_category;
+    const bool m_isRecording;
+    const std::chrono::steady_clock::time_point m_begin;
+};
+} // namespace cluon
+
 #endif
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -6096,16 +6283,47 @@ class LIBCLUON_API TerminateHandler {
 #define CLUON_NOTIFYINGPIPELINE_HPP
 
 //#include "cluon/cluon.hpp"
+//#include "cluon/Tracer.hpp"
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 
+#ifndef WIN32
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
 namespace cluon {
 
+/**
+Defines what NotifyingPipeline::add does when the pipeline is full.
+*/
+enum class OverflowPolicy : uint8_t {
+    BLOCK       = 0, // Wait until the delegate has freed a slot.
+    DROP_OLDEST = 1, // Discard the oldest entry that has not been processed yet.
+    DROP_NEWEST = 2, // Discard the entry to be added.
+};
+
+/**
+NotifyingPipeline hands entries from one producer thread to a delegate that is
+called in the pipeline's own thread. Entries are kept in a bounded lock-free
+ring buffer: add() only publishes the entry and never takes a lock, notifyAll()
+wakes the pipeline's thread that then drains all published entries as one batch.
+Entries are moved in and out, never copied.
+
+add() must only be called from one thread at a time. When the ring buffer is
+full, the OverflowPolicy decides whether add() waits, discards the oldest entry,
+or discards the new entry; discarded entries and the highest number of entries
+in flight are counted. An optional discard delegate gets the discarded entries
+in the producer's thread, e.g., to recycle their buffers.
+*/
 template <class T>
 class LIBCLUON_API NotifyingPipeline {
    private:
@@ -6115,8 +6333,28 @@ class LIBCLUON_API NotifyingPipeline {
     NotifyingPipeline &operator=(NotifyingPipeline &&) = delete;
 
    public:
-    NotifyingPipeline(std::function<void(T &&)> delegate)
-        : m_delegate(delegate) {
+    /**
+     * Constructor.
+     *
+     * @param delegate Function to call for each entry in the pipeline's thread.
+     * @param capacity Maximum number of entries in flight; rounded up to the next power of two, but at least 2.
+     * @param overflowPolicy What to do when an entry is added to a full pipeline.
+     * @param discardDelegate Function to call for each entry discarded by the OverflowPolicy.
+     */
+    NotifyingPipeline(std::function<void(T &&)> delegate,
+                      size_t capacity                          = 1024,
+                      OverflowPolicy overflowPolicy            = OverflowPolicy::BLOCK,
+                      std::function<void(T &&)> discardDelegate = nullptr)
+        : m_delegate(delegate)
+        , m_discardDelegate(discardDelegate)
+        , m_overflowPolicy(overflowPolicy)
+        , m_capacity(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_capacity - 1)
+        , m_ring(new Slot[m_capacity]) {
+        for (size_t i{0}; i < m_capacity; i++) {
+            m_ring[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+
         m_pipelineThread = std::thread(&NotifyingPipeline::processPipeline, this);
 
         // Let the operating system spawn the thread.
@@ -6128,7 +6366,9 @@ class LIBCLUON_API NotifyingPipeline {
         m_pipelineThreadRunning.store(false);
 
         // Wake any waiting threads.
-        m_pipelineCondition.notify_all();
+        notifyAll();
+        { std::lock_guard<std::mutex> lck(m_notFullMutex); }
+        m_notFullCondition.notify_all();
 
         // Joining the thread could fail.
         try {
@@ -6139,141 +6379,457 @@ class LIBCLUON_API NotifyingPipeline {
     }
 
    public:
+    /**
+     * This method publishes an entry to be processed; call notifyAll() after
+     * adding a batch of entries. It must only be called from one thread.
+     *
+     * @param entry Entry to be moved into the pipeline.
+     */
     inline void add(T &&entry) noexcept {
-        std::unique_lock<std::mutex> lck(m_pipelineMutex);
-        m_pipeline.emplace_back(entry);
+        const size_t TAIL{m_tail.load(std::memory_order_relaxed)};
+        Slot &slot = m_ring[TAIL & m_mask];
+        while (slot.m_sequence.load(std::memory_order_acquire) != TAIL) {
+            // The slot is still occupied, i.e., the pipeline is full.
+            if (OverflowPolicy::DROP_NEWEST == m_overflowPolicy) {
+                m_numberOfDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+                discard(std::move(entry));
+                return;
+            }
+            if (!m_pipelineThreadRunning.load()) {
+                return;
+            }
+            // Unless the delegate is just taking the oldest entry, discard it.
+            if ((OverflowPolicy::DROP_OLDEST == m_overflowPolicy) && (TAIL - m_head.load(std::memory_order_relaxed) >= m_capacity)) {
+                T discarded;
+                if (take(discarded)) {
+                    m_numberOfDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+                    discard(std::move(discarded));
+                }
+                continue;
+            }
+            // The pipeline's thread might not have been notified about the entries yet.
+            notifyAll();
+            if (OverflowPolicy::BLOCK == m_overflowPolicy) {
+                // Sleep until take() has freed the slot.
+                std::unique_lock<std::mutex> lck(m_notFullMutex);
+                m_producerWaiting.store(true);
+                m_notFullCondition.wait(lck, [this, &slot, TAIL] { return ((slot.m_sequence.load() == TAIL) || !m_pipelineThreadRunning.load()); });
+                m_producerWaiting.store(false);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        slot.m_entry = std::move(entry);
+        slot.m_sequence.store(TAIL + 1, std::memory_order_release);
+        m_tail.store(TAIL + 1, std::memory_order_release);
+
+        const size_t ENTRIES{TAIL + 1 - m_head.load(std::memory_order_relaxed)};
+        if (ENTRIES > m_highWaterMark.load(std::memory_order_relaxed)) {
+            m_highWaterMark.store(ENTRIES, std::memory_order_relaxed);
+        }
     }
 
-    inline void notifyAll() noexcept { m_pipelineCondition.notify_all(); }
+    inline void notifyAll() noexcept {
+        // Taking the mutex orders this notification after the pipeline thread's check for
+        // new entries; otherwise, the notification could get lost right before it waits.
+        { std::lock_guard<std::mutex> lck(m_pipelineMutex); }
+        m_pipelineCondition.notify_all();
+    }
 
     inline bool isRunning() noexcept { return m_pipelineThreadRunning.load(); }
 
+    /**
+     * @return Maximum number of entries in flight.
+     */
+    inline size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @return Number of entries discarded because the pipeline was full.
+     */
+    inline uint64_t numberOfDroppedEntries() const noexcept { return m_numberOfDroppedEntries.load(std::memory_order_relaxed); }
+
+    /**
+     * @return Highest number of entries that were in flight at the same time.
+     */
+    inline size_t highWaterMark() const noexcept { return m_highWaterMark.load(std::memory_order_relaxed); }
+
+    /**
+     * @return Number of entries currently in flight.
+     */
+    inline size_t size() const noexcept {
+        const size_t HEAD{m_head.load(std::memory_order_relaxed)};
+        const size_t TAIL{m_tail.load(std::memory_order_relaxed)};
+        return (TAIL > HEAD) ? TAIL - HEAD : 0;
+    }
+
+    /**
+     * This method changes the scheduling of the pipeline's thread; real-time
+     * priorities usually require CAP_SYS_NICE.
+     *
+     * @param priority Real-time priority (SCHED_FIFO) for the pipeline's thread; 0 selects the default scheduling.
+     * @return true if the scheduling could be changed.
+     */
+    inline bool setPriority(int32_t priority) noexcept {
+#ifdef WIN32
+        (void)priority;
+        return false;
+#else
+        sched_param param{};
+        param.sched_priority = (0 < priority) ? priority : 0;
+        return 0 == pthread_setschedparam(m_pipelineThread.native_handle(), (0 < priority) ? SCHED_FIFO : SCHED_OTHER, &param);
+#endif
+    }
+
    private:
+    // Each slot's sequence number tells whether it is free for the entry with
+    // the same index (sequence == index) or holds it (sequence == index + 1).
+    class Slot {
+       public:
+        std::atomic<size_t> m_sequence{0};
+        T m_entry{};
+    };
+
+    // A slot's sequence numbers for "holds entry i" and "free for entry i + capacity" must
+    // differ; thus, the ring buffer has at least two slots.
+    static size_t roundUpToPowerOfTwo(size_t n) noexcept {
+        size_t retVal{2};
+        while (retVal < n) {
+            retVal <<= 1;
+        }
+        return retVal;
+    }
+
+    inline void discard(T &&entry) noexcept {
+        if (nullptr != m_discardDelegate) {
+            try {
+                m_discardDelegate(std::move(entry));
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+    }
+
+    /**
+     * This method moves the oldest entry out of the ring buffer. It is called by the
+     * pipeline's thread and, to discard entries, by the producer; whoever advances
+     * m_head owns the slot.
+     *
+     * @return true if an entry was taken.
+     */
+    inline bool take(T &entry) noexcept {
+        size_t head{m_head.load(std::memory_order_relaxed)};
+        while (true) {
+            Slot &slot = m_ring[head & m_mask];
+            if (slot.m_sequence.load(std::memory_order_acquire) != head + 1) {
+                return false;
+            }
+            if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                entry = std::move(slot.m_entry);
+                slot.m_sequence.store(head + m_capacity, std::memory_order_release);
+                // Pairs with the producer announcing that it waits before it checks the slot.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (m_producerWaiting.load()) {
+                    { std::lock_guard<std::mutex> lck(m_notFullMutex); }
+                    m_notFullCondition.notify_one();
+                }
+                return true;
+            }
+        }
+    }
+
     inline void processPipeline() noexcept {
+        Tracer::instance().setThreadName("cluon::NotifyingPipeline");
+
         // Indicate to caller that we are ready.
         m_pipelineThreadRunning.store(true);
 
         while (m_pipelineThreadRunning.load()) {
-            std::unique_lock<std::mutex> lck(m_pipelineMutex);
-            // Wait until the thread should stop or data is available.
-            m_pipelineCondition.wait(lck, [this] { return (!this->m_pipelineThreadRunning.load() || !this->m_pipeline.empty()); });
-
-            // The condition will automatically lock the mutex after waking up.
-            // As we are locking per entry, we need to unlock the mutex first.
-            lck.unlock();
-
-            uint32_t entries{0};
             {
-                lck.lock();
-                entries = static_cast<uint32_t>(m_pipeline.size());
-                lck.unlock();
+                std::unique_lock<std::mutex> lck(m_pipelineMutex);
+                // Wait until the thread should stop or data is available.
+                m_pipelineCondition.wait(lck, [this] {
+                    return (!this->m_pipelineThreadRunning.load()
+                            || (this->m_head.load(std::memory_order_relaxed) != this->m_tail.load(std::memory_order_acquire)));
+                });
             }
-            for (uint32_t i{0}; i < entries; i++) {
-                T entry;
-                {
-                    lck.lock();
-                    entry = m_pipeline.front();
-                    lck.unlock();
-                }
 
+            // Drain all published entries without locking; each slot is handed
+            // back to the producer before its entry is processed.
+            T entry;
+            while (take(entry)) {
                 if (nullptr != m_delegate) {
                     m_delegate(std::move(entry));
                 }
-
-                {
-                    lck.lock();
-                    m_pipeline.pop_front();
-                    lck.unlock();
-                }
             }
         }
     }
 
    private:
     std::function<void(T &&)> m_delegate;
+    std::function<void(T &&)> m_discardDelegate;
+    const OverflowPolicy m_overflowPolicy;
 
     std::atomic<bool> m_pipelineThreadRunning{false};
     std::thread m_pipelineThread{};
     std::mutex m_pipelineMutex{};
     std::condition_variable m_pipelineCondition{};
 
-    std::deque<T> m_pipeline{};
+    // A producer blocked by OverflowPolicy::BLOCK sleeps until take() frees a slot.
+    std::mutex m_notFullMutex{};
+    std::condition_variable m_notFullCondition{};
+    std::atomic<bool> m_producerWaiting{false};
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_ring;
+
+    std::atomic<uint64_t> m_numberOfDroppedEntries{0};
+    std::atomic<size_t> m_highWaterMark{0};
+
+    // The pipeline's thread advances m_head (and so does the producer when discarding
+    // the oldest entry), the producer advances m_tail. The padding keeps them on
+    // separate cache lines.
+    std::array<char, 64> m_padding0{};
+    std::atomic<size_t> m_head{0};
+    std::array<char, 64> m_padding1{};
+    std::atomic<size_t> m_tail{0};
+    std::array<char, 64> m_padding2{};
 };
 } // namespace cluon
 
 #endif
 /*
- * Copyright (C) 2019  Christian Berger
+ * Copyright (C) 2021  Group 17
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
-#ifndef CLUON_IPV4TOOLS_HPP
-#define CLUON_IPV4TOOLS_HPP
+#ifndef CLUON_LATESTVALUE_HPP
+#define CLUON_LATESTVALUE_HPP
 
-#include <string>
+//#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
 
-namespace cluon {
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
+namespace cluon {
 /**
- * @return IPv4-formatted string for the given hostname or the empty string.
- */
-std::string getIPv4FromHostname(const std::string &hostname) noexcept;
-
-} // namespace cluon
+LatestValue keeps the most recent value of a message together with the time
+stamp when it was received, e.g., to sample the state published by other
+microservices from a control loop running at its own rate:
 
-#endif
-/*
- * Copyright (C) 2017-2018  Christian Berger
- *
- * This Source Code Form is subject to the terms of the Mozilla Public
- * License, v. 2.0. If a copy of the MPL was not distributed with this
- * file, You can obtain one at http://mozilla.org/MPL/2.0/.
- */
-
-#ifndef CLUON_UDPPACKETSIZECONSTRAINTS_H
-#define CLUON_UDPPACKETSIZECONSTRAINTS_H
-
-#include <cstdint>
+\code{.cpp}
+cluon::OD4Session od4{111};
+cluon::LatestValue<opendlv::proxy::GroundSteeringRequest> gsr;
+od4.keepLatest(gsr);
 
-// clang-format off
-namespace cluon {
-    enum class UDPPacketSizeConstraints : uint16_t {
-        SIZE_IPv4_HEADER    = 20,
-        SIZE_UDP_HEADER     = 8,
-        MAX_SIZE_UDP_PACKET = 0xFFFF, };
+opendlv::proxy::GroundSteeringRequest request;
+if (gsr.load(request)) {
+  // Use request.groundSteering().
 }
-// clang-format on
-
-#endif
-/*
- * Copyright (C) 2017-2018  Christian Berger
- *
- * This Source Code Form is subject to the terms of the Mozilla Public
- * License, v. 2.0. If a copy of the MPL was not distributed with this
- * file, You can obtain one at http://mozilla.org/MPL/2.0/.
- */
+\endcode
 
-#ifndef CLUON_UDPSENDER_HPP
-#define CLUON_UDPSENDER_HPP
+One thread at a time stores values and any number of threads load them;
+nobody takes a lock. store() is wait-free. The values are kept in a few slots that are
+written in turn, each protected by a sequence number (seqlock): load() copies
+the most recent slot and only repeats the copy in the unlikely event that the
+writer has come around to that very slot meanwhile. Therefore, T must be
+trivially copyable, which holds for messages with numerical fields only.
+*/
+template <typename T>
+class LIBCLUON_API LatestValue {
+    static_assert(std::is_trivially_copyable<T>::value, "cluon::LatestValue requires a trivially copyable type.");
 
-//#include "cluon/cluon.hpp"
+   private:
+    LatestValue(const LatestValue &) = delete;
+    LatestValue(LatestValue &&)      = delete;
+    LatestValue &operator=(const LatestValue &) = delete;
+    LatestValue &operator=(LatestValue &&) = delete;
 
-// clang-format off
-#ifdef WIN32
-    #include <Winsock2.h> // for WSAStartUp
-    #include <ws2tcpip.h> // for SOCKET
-#else
-    #include <netinet/in.h>
-#endif
-// clang-format on
+   public:
+    LatestValue()  = default;
+    ~LatestValue() = default;
 
-#include <cstdint>
+   public:
+    /**
+     * This method stores a new value; it must not be called by several
+     * threads at the same time as concurrent stores would tear the value.
+     *
+     * @param value Value to store.
+     * @param timeStamp Time stamp when the value was received.
+     */
+    inline void store(const T &value, const cluon::data::TimeStamp &timeStamp) noexcept {
+        Entry entry;
+        entry.m_value     = value;
+        entry.m_timeStamp = timeStamp;
+        std::array<uint64_t, WORDS> words{};
+        std::memcpy(words.data(), &entry, sizeof(Entry));
+
+        const uint64_t VERSION{m_version.load(std::memory_order_relaxed) + 1};
+        Slot &slot = m_slots[VERSION % SLOTS];
+        // An odd sequence number marks the slot as being written.
+        const uint64_t SEQUENCE{slot.m_sequence.load(std::memory_order_relaxed)};
+        slot.m_sequence.store(SEQUENCE + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i{0}; i < WORDS; i++) {
+            slot.m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.m_sequence.store(SEQUENCE + 2, std::memory_order_release);
+        m_version.store(VERSION, std::memory_order_release);
+    }
+
+    /**
+     * This method copies the latest value without blocking.
+     *
+     * @param value Latest value.
+     * @param timeStamp Time stamp when the latest value was received.
+     * @return false if no value was stored yet; value and timeStamp are unchanged then.
+     */
+    inline bool load(T &value, cluon::data::TimeStamp &timeStamp) const noexcept {
+        std::array<uint64_t, WORDS> words{};
+        while (true) {
+            const uint64_t VERSION{m_version.load(std::memory_order_acquire)};
+            if (0 == VERSION) {
+                return false;
+            }
+            const Slot &slot = m_slots[VERSION % SLOTS];
+            const uint64_t BEFORE{slot.m_sequence.load(std::memory_order_acquire)};
+            if (0 != (BEFORE & 1)) {
+                continue;
+            }
+            for (std::size_t i{0}; i < WORDS; i++) {
+                words[i] = slot.m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (BEFORE == slot.m_sequence.load(std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        Entry entry;
+        std::memcpy(&entry, words.data(), sizeof(Entry));
+        value     = entry.m_value;
+        timeStamp = entry.m_timeStamp;
+        return true;
+    }
+
+    /**
+     * This method copies the latest value without blocking.
+     *
+     * @param value Latest value.
+     * @return false if no value was stored yet; value is unchanged then.
+     */
+    inline bool load(T &value) const noexcept {
+        cluon::data::TimeStamp timeStamp;
+        return load(value, timeStamp);
+    }
+
+    /**
+     * @return Number of values stored so far.
+     */
+    inline uint64_t numberOfUpdates() const noexcept { return m_version.load(std::memory_order_relaxed); }
+
+   private:
+    class Entry {
+       public:
+        T m_value{};
+        cluon::data::TimeStamp m_timeStamp{};
+    };
+    static constexpr std::size_t WORDS{(sizeof(Entry) + sizeof(uint64_t) - 1) / sizeof(uint64_t)};
+    static constexpr std::size_t SLOTS{4};
+
+    // Each slot sits on a cache line of its own.
+    class alignas(64) Slot {
+       public:
+        std::atomic<uint64_t> m_sequence{0};
+        std::array<std::atomic<uint64_t>, WORDS> m_words{};
+    };
+
+   private:
+    std::atomic<uint64_t> m_version{0};
+    std::array<Slot, SLOTS> m_slots{};
+};
+} // namespace cluon
+
+#endif
+/*
+ * Copyright (C) 2019  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_IPV4TOOLS_HPP
+#define CLUON_IPV4TOOLS_HPP
+
+#include <string>
+
+namespace cluon {
+
+/**
+ * @return IPv4-formatted string for the given hostname or the empty string.
+ */
+std::string getIPv4FromHostname(const std::string &hostname) noexcept;
+
+} // namespace cluon
+
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_UDPPACKETSIZECONSTRAINTS_H
+#define CLUON_UDPPACKETSIZECONSTRAINTS_H
+
+#include <cstdint>
+
+// clang-format off
+namespace cluon {
+    enum class UDPPacketSizeConstraints : uint16_t {
+        SIZE_IPv4_HEADER    = 20,
+        SIZE_UDP_HEADER     = 8,
+        MAX_SIZE_UDP_PACKET = 0xFFFF, };
+}
+// clang-format on
+
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_UDPSENDER_HPP
+#define CLUON_UDPSENDER_HPP
+
+//#include "cluon/cluon.hpp"
+
+// clang-format off
+#ifdef WIN32
+    #include <Winsock2.h> // for WSAStartUp
+    #include <ws2tcpip.h> // for SOCKET
+#else
+    #include <netinet/in.h>
+#endif
+// clang-format on
+
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -6300,6 +6856,16 @@ std::pair<ssize_t, int32_t> retVal = sender.send(std::move("Hello World!"));
 std::cout << "Send " << retVal.first << " bytes, error code = " << retVal.second << std::endl;
 \endcode
 
+To send several small packets with fewer system calls, queue them with the
+method `queue` and send them together with the method `flush`; on Linux, all
+queued packets are handed to the kernel with one `sendmmsg` system call.
+
+\code{.cpp}
+sender.queue(first.data(), first.size());
+sender.queue(second.data(), second.size());
+sender.flush();
+\endcode
+
 A complete example is available
 [here](https://github.com/chrberger/libcluon/blob/master/libcluon/examples/cluon-UDPSender.cpp).
 */
@@ -6328,17 +6894,80 @@ class LIBCLUON_API UDPSender {
      */
     std::pair<ssize_t, int32_t> send(std::string &&data) const noexcept;
 
+    /**
+     * Send a given buffer as UDP packet.
+     *
+     * @param data Pointer to the bytes to send.
+     * @param size Number of bytes to send.
+     * @return Pair: Number of bytes sent and errno.
+     */
+    std::pair<ssize_t, int32_t> send(const char *data, std::size_t size) const noexcept;
+
+    /**
+     * Queue a copy of a given buffer to be sent as UDP packet with the next
+     * call to flush; a full batch is flushed right away.
+     *
+     * @param data Pointer to the bytes to send.
+     * @param size Number of bytes to send.
+     * @return Pair: Number of bytes queued and errno.
+     */
+    std::pair<ssize_t, int32_t> queue(const char *data, std::size_t size) noexcept;
+
+    /**
+     * Send all queued packets; on Linux, the packets are sent with one
+     * sendmmsg system call per batch.
+     *
+     * @return Pair: Number of bytes sent and errno of the first failed packet.
+     */
+    std::pair<ssize_t, int32_t> flush() noexcept;
+
+    /**
+     * This method enables or disables that sent multicast packets are also
+     * delivered to the receiving sockets on this host (default: enabled).
+     *
+     * @param enable true to loop sent multicast packets back to this host.
+     * @return true if the setting was applied.
+     */
+    bool multicastLoopback(bool enable) noexcept;
+
    public:
     /**
      * @return Port that this UDP sender will use for sending or 0 if no information available.
      */
     uint16_t getSendFromPort() const noexcept;
 
+    /**
+     * @return Number of packets sent so far.
+     */
+    uint64_t numberOfSentPackets() const noexcept;
+
+    /**
+     * @return Number of send system calls issued so far; together with
+     *         numberOfSentPackets, this gives the packets per system call.
+     */
+    uint64_t numberOfSendCalls() const noexcept;
+
+   private:
+    /**
+     * This method sends the queued packets; m_socketMutex must be locked.
+     */
+    std::pair<ssize_t, int32_t> flushQueue() noexcept;
+
    private:
+    // Maximum number of packets to queue before they are flushed with one sendmmsg system call on Linux.
+    static constexpr uint32_t SEND_BATCH_SIZE{64};
+
     mutable std::mutex m_socketMutex{};
     int32_t m_socket{-1};
     uint16_t m_portToSentFrom{0};
     struct sockaddr_in m_sendToAddress {};
+
+    // Queued packets stored back to back and their offsets and lengths; guarded by m_socketMutex.
+    std::string m_queuedData{};
+    std::vector<std::pair<std::size_t, std::size_t>> m_queuedPackets{};
+
+    mutable std::atomic<uint64_t> m_numberOfSentPackets{0};
+    mutable std::atomic<uint64_t> m_numberOfSendCalls{0};
 };
 } // namespace cluon
 
@@ -6377,8 +7006,56 @@ class LIBCLUON_API UDPSender {
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace cluon {
+/**
+A datagram as handed to a UDPReceiver's delegate: a view into a pooled receive
+buffer, the sender's raw IPv4 address, and the receive time stamp. The view is
+only valid during the delegate call; the sender is formatted only on demand.
+*/
+class LIBCLUON_API UDPDatagram {
+   public:
+    UDPDatagram(const char *data, size_t size, const struct sockaddr_in &sender, std::chrono::system_clock::time_point sampleTime) noexcept;
+
+   public:
+    /**
+     * @return Pointer to the received bytes.
+     */
+    const char *data() const noexcept;
+
+    /**
+     * @return Number of received bytes.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @return Copy of the received bytes.
+     */
+    std::string dataAsString() const noexcept;
+
+    /**
+     * @return Raw address of the sender.
+     */
+    const struct sockaddr_in &sender() const noexcept;
+
+    /**
+     * @return Human-readable representation of the sender (X.Y.Z.W:ABCD).
+     */
+    std::string senderAsString() const noexcept;
+
+    /**
+     * @return Time point when the datagram was received.
+     */
+    std::chrono::system_clock::time_point sampleTime() const noexcept;
+
+   private:
+    const char *m_data;
+    size_t m_size;
+    struct sockaddr_in m_sender;
+    std::chrono::system_clock::time_point m_sampleTime;
+};
+
 /**
 To receive data from a UDP socket, simply include the header
 `#include <cluon/UDPReceiver.hpp>`.
@@ -6408,6 +7085,18 @@ cluon::UDPReceiver receiver("127.0.0.1", 1234,
     });
 \endcode
 
+To avoid copying the received bytes and formatting the sender for every
+datagram, a delegate with the signature
+`std::function<void(const cluon::UDPDatagram &)>` can be supplied instead; it
+receives a view into a receive buffer that is re-used after the delegate returns:
+
+\code{.cpp}
+cluon::UDPReceiver receiver("127.0.0.1", 1234,
+    [](const cluon::UDPDatagram &datagram) noexcept {
+        std::cout << "Received " << datagram.size() << " bytes from " << datagram.senderAsString() << std::endl;
+    });
+\endcode
+
 After creating an instance of class `cluon::UDPReceiver`, it is immediately
 activated and concurrently waiting for data in a separate thread. To check
 whether the instance was created successfully and running, the method
@@ -6436,6 +7125,25 @@ class LIBCLUON_API UDPReceiver {
                 uint16_t receiveFromPort,
                 std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
                 uint16_t localSendFromPort = 0) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param receiveFromAddress Numerical IPv4 address to receive UDP packets from.
+     * @param receiveFromPort Port to receive UDP packets from.
+     * @param delegate Functional (noexcept) to handle a received datagram that is only valid during the call.
+     * @param localSendFromPort Port that an application is using to send data. This port (> 0) is ignored when data is received.
+     * @param queueCapacity Maximum number of datagrams waiting for the delegate.
+     * @param overflowPolicy What to do with a datagram when queueCapacity datagrams are waiting; by default, the
+     *        receiving thread waits for the delegate so that no datagram is lost in between. OverflowPolicy::DROP_OLDEST
+     *        lets a slow delegate see the most recent data instead.
+     */
+    UDPReceiver(const std::string &receiveFromAddress,
+                uint16_t receiveFromPort,
+                std::function<void(const UDPDatagram &)> delegate,
+                uint16_t localSendFromPort    = 0,
+                size_t queueCapacity          = 1024,
+                OverflowPolicy overflowPolicy = OverflowPolicy::BLOCK) noexcept;
     ~UDPReceiver() noexcept;
 
     /**
@@ -6443,6 +7151,32 @@ class LIBCLUON_API UDPReceiver {
      */
     bool isRunning() const noexcept;
 
+    /**
+     * @return Number of datagrams received so far.
+     */
+    uint64_t numberOfReceivedPackets() const noexcept;
+
+    /**
+     * @return Number of receive system calls issued so far; together with
+     *         numberOfReceivedPackets, this gives the packets per system call.
+     */
+    uint64_t numberOfReceiveCalls() const noexcept;
+
+    /**
+     * @return Number of datagrams discarded because the delegate could not keep up.
+     */
+    uint64_t numberOfDroppedPackets() const noexcept;
+
+    /**
+     * @return Highest number of datagrams that were waiting for the delegate at the same time.
+     */
+    size_t queueHighWaterMark() const noexcept;
+
+    /**
+     * @return Inode of the receiving socket as listed in /proc/net/udp or 0 if not available.
+     */
+    uint64_t socketInode() const noexcept;
+
    private:
     /**
      * This method closes the socket.
@@ -6453,11 +7187,33 @@ class LIBCLUON_API UDPReceiver {
 
     void readFromSocket() noexcept;
 
+    /**
+     * This method filters a received datagram and queues it for the delegate.
+     *
+     * @return true if the datagram was queued.
+     */
+    bool processDatagram(const char *data, size_t length, const struct sockaddr_storage &remote, std::chrono::system_clock::time_point timestamp) noexcept;
+
+    /**
+     * @return Receive buffer from the pool or a new one if the pool is empty.
+     */
+    std::vector<char> acquireBuffer() noexcept;
+
+    /**
+     * This method returns a receive buffer to the pool keeping its capacity.
+     */
+    void releaseBuffer(std::vector<char> &&buffer) noexcept;
+
    private:
+    // Number of datagrams to receive with one recvmmsg system call on Linux.
+    static constexpr uint32_t RECEIVE_BATCH_SIZE{16};
+
     int32_t m_socket{-1};
     bool m_isBlockingSocket{true};
     std::set<unsigned long> m_listOfLocalIPAddresses{};
     uint16_t m_localSendFromPort;
+    size_t m_queueCapacity;
+    OverflowPolicy m_overflowPolicy;
     struct sockaddr_in m_receiveFromAddress {};
     struct ip_mreq m_mreq {};
     bool m_isMulticast{false};
@@ -6465,15 +7221,29 @@ class LIBCLUON_API UDPReceiver {
     std::atomic<bool> m_readFromSocketThreadRunning{false};
     std::thread m_readFromSocketThread{};
 
+    std::atomic<uint64_t> m_numberOfReceivedPackets{0};
+    std::atomic<uint64_t> m_numberOfReceiveCalls{0};
+
+#ifdef __linux__
+    // The receiving thread blocks in epoll_wait on the socket and on an eventfd that is signalled to stop it.
+    int32_t m_epoll{-1};
+    int32_t m_wakeUp{-1};
+#endif
+
    private:
-    std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point)> m_delegate{};
+    std::function<void(const UDPDatagram &)> m_delegate{};
 
    private:
+    // Receive buffers are recycled between the receiving thread and the pipeline's thread.
+    static constexpr size_t MAX_POOLED_BUFFERS{1024};
+    std::mutex m_bufferPoolMutex{};
+    std::vector<std::vector<char>> m_bufferPool{};
+
     class PipelineEntry {
        public:
-        std::string m_data;
-        std::string m_from;
-        std::chrono::system_clock::time_point m_sampleTime;
+        std::vector<char> m_data{};
+        struct sockaddr_in m_from {};
+        std::chrono::system_clock::time_point m_sampleTime{};
     };
 
     std::shared_ptr<cluon::NotifyingPipeline<PipelineEntry>> m_pipeline{};
@@ -6765,14 +7535,19 @@ namespace cluon {
 
 //#include "cluon/ProtoConstants.hpp"
 //#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <sstream>
 #include <string>
+#include <utility>
 
 namespace cluon {
 /**
-This class encodes a given message in Proto format.
+This class encodes a given message in Proto format. The encoded bytes are
+appended to a contiguous buffer, either the visitor's own or one provided by
+the caller; nested messages are encoded in place after their precomputed size.
 */
 class LIBCLUON_API ToProtoVisitor {
    private:
@@ -6782,7 +7557,15 @@ class LIBCLUON_API ToProtoVisitor {
     ToProtoVisitor &operator=(ToProtoVisitor &&) = delete;
 
    public:
-    ToProtoVisitor()  = default;
+    ToProtoVisitor() = default;
+
+    /**
+     * Constructor to append the encoded data to the given buffer. Reusing a
+     * buffer encodes without any allocation once its capacity suffices.
+     *
+     * @param buffer Buffer to append the encoded data to; it must outlive this visitor.
+     */
+    explicit ToProtoVisitor(std::string &buffer) noexcept;
     ~ToProtoVisitor() = default;
 
     /**
@@ -6790,6 +7573,25 @@ class LIBCLUON_API ToProtoVisitor {
      */
     std::string encodedData() const noexcept;
 
+    /**
+     * @return Number of bytes encoded by this visitor.
+     */
+    std::size_t encodedSize() const noexcept;
+
+    /**
+     * This method computes the size of the Proto encoding of the given value
+     * without encoding it.
+     *
+     * @param value Value to compute the encoded size for.
+     * @return Number of bytes that value is encoded into.
+     */
+    template <typename T>
+    static std::size_t encodedSize(T &value) noexcept {
+        cluon::ToProtoVisitor sizeCalculator{static_cast<std::string *>(nullptr)};
+        sizeCalculator.acceptMessage(value, 0);
+        return sizeCalculator.m_size;
+    }
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -6810,60 +7612,106 @@ class LIBCLUON_API ToProtoVisitor {
     void visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept;
     void visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept;
     void visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept;
+    void visit(uint32_t &id, std::string &&typeName, std::string &&name, cluon::data::TimeStamp &v) noexcept;
 
     template <typename T>
     void visit(uint32_t &id, std::string &&typeName, std::string &&name, T &value) noexcept {
         (void)typeName;
         (void)name;
 
-        toVarInt(m_buffer, std::move(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED))));
-        cluon::ToProtoVisitor nestedProtoEncoder;
-        value.accept(nestedProtoEncoder);
-        encode(m_buffer, std::move(nestedProtoEncoder.encodedData()));
+        toVarInt(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED)));
+        // The length precedes the nested message; thus, it is computed first
+        // to encode the nested message in place afterwards.
+        toVarInt(encodedSize(value));
+        cluon::ToProtoVisitor nestedProtoEncoder{m_out};
+        nestedProtoEncoder.acceptMessage(value, 0);
+        m_size += nestedProtoEncoder.m_size;
     }
 
-   private:
-    std::size_t encode(std::ostream &o, bool &v) noexcept;
-    std::size_t encode(std::ostream &o, int8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, float &v) noexcept;
-    std::size_t encode(std::ostream &o, double &v) noexcept;
-    std::size_t encode(std::ostream &o, const std::string &v) noexcept;
-
-   private:
-    uint8_t toZigZag8(int8_t v) noexcept;
-    uint16_t toZigZag16(int16_t v) noexcept;
-    uint32_t toZigZag32(int32_t v) noexcept;
-    uint64_t toZigZag64(int64_t v) noexcept;
-
     /**
-     * This method encodes a given value in VarInt.
+     * This method is called by the Proto codec of messages generated with
+     * cluon-msc --proto-codec, which passes neither type nor field names.
      *
-     * @param out std::ostream to encode to.
+     * @param id Field identifier.
      * @param v Value to encode.
-     * @return Bytes written.
      */
-    std::size_t toVarInt(std::ostream &out, uint64_t v) noexcept;
+    template <typename T>
+    void visit(uint32_t id, T &v) noexcept {
+        visit(id, std::string(), std::string(), v);
+    }
 
+   private:
     /**
-     * This method creates a key/value pair encoded in Proto format.
+     * This method visits all fields of the given message, preferably through
+     * its Proto codec if it was generated with cluon-msc --proto-codec.
      *
-     * @param fieldIdentifier Field identifier.
-     * @param v Value to encode.
-     * @return Bytes written.
+     * @param value Message to encode.
      */
     template <typename T>
-    std::size_t toKeyValue(uint32_t fieldIdentifier, T &v) noexcept {
-        std::size_t size{0};
+    auto acceptMessage(T &value, int) noexcept -> decltype(value.acceptProto(std::declval<ToProtoVisitor &>()), void()) {
+        value.acceptProto(*this);
+    }
+    template <typename T>
+    void acceptMessage(T &value, long) noexcept {
+        value.accept(*this);
+    }
+
+   private:
+    /**
+     * Constructor to append the encoded data to the given buffer.
+     *
+     * @param out Buffer to append to; nullptr only counts the bytes.
+     */
+    explicit ToProtoVisitor(std::string *out) noexcept;
+
+    std::size_t encode(bool &v) noexcept;
+    std::size_t encode(int8_t &v) noexcept;
+    std::size_t encode(uint8_t &v) noexcept;
+    std::size_t encode(int16_t &v) noexcept;
+    std::size_t encode(uint16_t &v) noexcept;
+    std::size_t encode(int32_t &v) noexcept;
+    std::size_t encode(uint32_t &v) noexcept;
+    std::size_t encode(int64_t &v) noexcept;
+    std::size_t encode(uint64_t &v) noexcept;
+    std::size_t encode(float &v) noexcept;
+    std::size_t encode(double &v) noexcept;
+    std::size_t encode(const std::string &v) noexcept;
+
+    /**
+     * This method appends the given bytes to the buffer.
+     *
+     * @param data Bytes to append.
+     * @param size Number of bytes.
+     */
+    void write(const char *data, std::size_t size) noexcept;
+
+   private:
+    uint8_t toZigZag8(int8_t v) noexcept;
+    uint16_t toZigZag16(int16_t v) noexcept;
+    uint32_t toZigZag32(int32_t v) noexcept;
+    uint64_t toZigZag64(int64_t v) noexcept;
+
+    /**
+     * This method encodes a given value in VarInt.
+     *
+     * @param v Value to encode.
+     * @return Bytes written.
+     */
+    std::size_t toVarInt(uint64_t v) noexcept;
+
+    /**
+     * This method creates a key/value pair encoded in Proto format.
+     *
+     * @param fieldIdentifier Field identifier.
+     * @param v Value to encode.
+     * @return Bytes written.
+     */
+    template <typename T>
+    std::size_t toKeyValue(uint32_t fieldIdentifier, T &v) noexcept {
+        std::size_t size{0};
         uint64_t key = encodeKey(fieldIdentifier, static_cast<uint8_t>(ProtoConstants::VARINT));
-        size += toVarInt(m_buffer, key);
-        size += encode(m_buffer, v);
+        size += toVarInt(key);
+        size += encode(v);
         return size;
     }
 
@@ -6877,7 +7725,10 @@ class LIBCLUON_API ToProtoVisitor {
     uint64_t encodeKey(uint32_t fieldIdentifier, uint8_t protoType) noexcept;
 
    private:
-    std::stringstream m_buffer{""};
+    std::string m_buffer{};
+    // Buffer to append to: m_buffer or a caller-provided one; nullptr to only count the bytes.
+    std::string *m_out{&m_buffer};
+    std::size_t m_size{0};
 };
 } // namespace cluon
 
@@ -6895,6 +7746,7 @@ class LIBCLUON_API ToProtoVisitor {
 
 //#include "cluon/ProtoConstants.hpp"
 //#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
 //#include "cluon/any/any.hpp"
 
 #include <cstdint>
@@ -6903,6 +7755,7 @@ class LIBCLUON_API ToProtoVisitor {
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cluon {
@@ -6929,6 +7782,15 @@ class LIBCLUON_API FromProtoVisitor {
      */
     void decodeFrom(std::istream &in) noexcept;
 
+    /**
+     * This method decodes the given bytes into Proto without copying them
+     * into an intermediate stream.
+     *
+     * @param data Pointer to the bytes to decode.
+     * @param size Number of bytes to decode.
+     */
+    void decodeFrom(const char *data, std::size_t size) noexcept;
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -6956,9 +7818,9 @@ class LIBCLUON_API FromProtoVisitor {
         (void)name;
 
         if (m_callToDecodeFromWithDirectVisit) {
-            std::stringstream sstr{std::move(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value)))};
+            // Decode the nested message in place from the enclosing bytes.
             cluon::FromProtoVisitor nestedProtoDecoder;
-            nestedProtoDecoder.decodeFrom(sstr, v);
+            nestedProtoDecoder.decodeFrom(m_bytes, static_cast<std::size_t>(m_value), v);
         }
         else if (0 < m_mapOfKeyValues.count(id)) {
             try {
@@ -6971,6 +7833,18 @@ class LIBCLUON_API FromProtoVisitor {
         }
     }
 
+    /**
+     * This method is called by the Proto codec of messages generated with
+     * cluon-msc --proto-codec, which passes neither type nor field names.
+     *
+     * @param id Field identifier.
+     * @param v Field to receive the decoded value.
+     */
+    template <typename T>
+    void visit(uint32_t id, T &v) noexcept {
+        visit(id, std::string(), std::string(), v);
+    }
+
    public:
     /**
      * This method decodes a given istream into corresponding fields of v.
@@ -6992,21 +7866,21 @@ class LIBCLUON_API FromProtoVisitor {
                     {
                         // Directly decode VarInt value.
                         fromVarInt(in, m_value);
-                        v.accept(m_fieldId, *this);
+                        acceptField(v);
                     }
                     break;
                     case ProtoConstants::EIGHT_BYTES:
                     {
                         readBytesFromStream(in, sizeof(double), m_doubleValue.buffer.data());
                         m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
-                        v.accept(m_fieldId, *this);
+                        acceptField(v);
                     }
                     break;
                     case ProtoConstants::FOUR_BYTES:
                     {
                         readBytesFromStream(in, sizeof(float), m_floatValue.buffer.data());
                         m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
-                        v.accept(m_fieldId, *this);
+                        acceptField(v);
                     }
                     break;
                     case ProtoConstants::LENGTH_DELIMITED:
@@ -7017,7 +7891,8 @@ class LIBCLUON_API FromProtoVisitor {
                             m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
                         }
                         readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
-                        v.accept(m_fieldId, *this);
+                        m_bytes = m_stringValue.data();
+                        acceptField(v);
                     }
                     break;
                 }
@@ -7026,6 +7901,107 @@ class LIBCLUON_API FromProtoVisitor {
         m_callToDecodeFromWithDirectVisit = false;
     }
 
+    /**
+     * This method decodes the given bytes into corresponding fields of v.
+     * Strings and nested messages are read directly from the given bytes;
+     * no intermediate stream or buffer is used.
+     *
+     * @param data Pointer to the bytes to decode.
+     * @param size Number of bytes to decode.
+     * @param v Data structure to receive the decoded values.
+     */
+    template<typename T>
+    void decodeFrom(const char *data, std::size_t size, T &v) noexcept {
+        if (nullptr == data) {
+            return;
+        }
+        m_callToDecodeFromWithDirectVisit = true;
+        const char *pos{data};
+        const char *end{data + size};
+        while (pos < end) {
+            // First stage: Read keyFieldType (encoded as VarInt).
+            if (0 == fromVarInt(pos, end, m_keyFieldType)) {
+                break;
+            }
+            m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
+            m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
+            switch (m_protoType) {
+                case ProtoConstants::VARINT:
+                {
+                    fromVarInt(pos, end, m_value);
+                    acceptField(v);
+                }
+                break;
+                case ProtoConstants::EIGHT_BYTES:
+                {
+                    if (static_cast<std::size_t>(end - pos) < sizeof(double)) {
+                        pos = end;
+                        break;
+                    }
+                    std::memcpy(m_doubleValue.buffer.data(), pos, sizeof(double));
+                    pos += sizeof(double);
+                    m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
+                    acceptField(v);
+                }
+                break;
+                case ProtoConstants::FOUR_BYTES:
+                {
+                    if (static_cast<std::size_t>(end - pos) < sizeof(float)) {
+                        pos = end;
+                        break;
+                    }
+                    std::memcpy(m_floatValue.buffer.data(), pos, sizeof(float));
+                    pos += sizeof(float);
+                    m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
+                    acceptField(v);
+                }
+                break;
+                case ProtoConstants::LENGTH_DELIMITED:
+                {
+                    fromVarInt(pos, end, m_value);
+                    if (static_cast<uint64_t>(end - pos) < m_value) {
+                        pos = end;
+                        break;
+                    }
+                    m_bytes = pos;
+                    pos += m_value;
+                    acceptField(v);
+                }
+                break;
+                default:
+                {
+                    // Unknown wire type; the remaining bytes cannot be interpreted.
+                    pos = end;
+                }
+                break;
+            }
+        }
+        m_callToDecodeFromWithDirectVisit = false;
+    }
+
+   private:
+    /**
+     * This method assigns the value decoded last to the field m_fieldId of v,
+     * preferably through its Proto codec if it was generated with cluon-msc
+     * --proto-codec.
+     *
+     * @param v Data structure to receive the decoded value.
+     */
+    template <typename T>
+    void acceptField(T &v) noexcept {
+        acceptField(v, 0);
+    }
+    void acceptField(cluon::data::Envelope &v) noexcept;
+
+    template <typename T>
+    auto acceptField(T &v, int) noexcept -> decltype(v.acceptProto(uint32_t{0}, std::declval<FromProtoVisitor &>()), void()) {
+        v.acceptProto(m_fieldId, *this);
+    }
+    template <typename T>
+    void acceptField(T &v, long) noexcept {
+        v.accept(m_fieldId, *this);
+    }
+
    private:
     int8_t fromZigZag8(uint8_t v) noexcept;
     int16_t fromZigZag16(uint16_t v) noexcept;
@@ -7033,6 +8009,7 @@ class LIBCLUON_API FromProtoVisitor {
     int64_t fromZigZag64(uint64_t v) noexcept;
 
     std::size_t fromVarInt(std::istream &in, uint64_t &value) noexcept;
+    std::size_t fromVarInt(const char *&pos, const char *end, uint64_t &value) noexcept;
 
     void readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept;
 
@@ -7062,6 +8039,9 @@ class LIBCLUON_API FromProtoVisitor {
 
     // Buffer for strings.
     std::vector<char> m_stringValue;
+    // Start of the current length-delimited value (m_value bytes), either in
+    // m_stringValue or in the bytes being decoded.
+    const char *m_bytes{nullptr};
 
     uint64_t m_keyFieldType{0};
     ProtoConstants m_protoType{ProtoConstants::VARINT};
@@ -8021,6 +9001,89 @@ class LIBCLUON_API ToMsgPackVisitor {
 
 namespace cluon {
 
+/**
+ * This method writes the OD4 header in front of an Envelope encoded into the
+ * given buffer after OD4_HEADER_SIZE reserved bytes:
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * 0xA4 LEN0 LEN1 LEN2 are little Endian.
+ *
+ * @param buffer Buffer starting with five reserved bytes.
+ */
+inline void writeOD4Header(std::string &buffer) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    if (OD4_HEADER_SIZE <= buffer.size()) {
+        const std::size_t LENGTH{buffer.size() - OD4_HEADER_SIZE};
+        buffer[0] = static_cast<char>(0x0D);
+        buffer[1] = static_cast<char>(0xA4);
+        buffer[2] = static_cast<char>(LENGTH & 0xFF);
+        buffer[3] = static_cast<char>((LENGTH >> 8) & 0xFF);
+        buffer[4] = static_cast<char>((LENGTH >> 16) & 0xFF);
+    }
+}
+
+/**
+ * This method encodes a given Envelope with its OD4 header into the given
+ * buffer, replacing its content. Reusing the buffer avoids allocations once
+ * its capacity suffices.
+ *
+ * @param buffer Buffer to encode into.
+ * @param envelope Envelope with payload to be sent.
+ */
+inline void serializeEnvelope(std::string &buffer, cluon::data::Envelope &envelope) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    buffer.assign(OD4_HEADER_SIZE, '\0');
+    cluon::ToProtoVisitor protoEncoder{buffer};
+    envelope.accept(protoEncoder);
+    writeOD4Header(buffer);
+}
+
+/**
+ * This method encodes an Envelope carrying the given message with its OD4
+ * header into the given buffer, replacing its content. The message is encoded
+ * in place into the Envelope's field serializedData; thus, neither the message
+ * nor the Envelope need a buffer of their own. Reusing the buffer avoids
+ * allocations once its capacity suffices.
+ *
+ * @param buffer Buffer to encode into.
+ * @param message Message to be sent.
+ * @param sent Time point when the Envelope is sent.
+ * @param sampleTimeStamp Time point when the message was captured.
+ * @param senderStamp Sender stamp.
+ */
+template <typename T>
+inline void serializeEnvelope(std::string &buffer,
+                              T &message,
+                              const cluon::data::TimeStamp &sent,
+                              const cluon::data::TimeStamp &sampleTimeStamp,
+                              uint32_t senderStamp) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    buffer.assign(OD4_HEADER_SIZE, '\0');
+    cluon::ToProtoVisitor protoEncoder{buffer};
+
+    // Same fields in the same order as cluon::data::Envelope::accept; the
+    // encoded message is the payload of the field serializedData.
+    uint32_t id{1};
+    int32_t dataType{static_cast<int32_t>(T::ID())};
+    protoEncoder.visit(id, std::string(), std::string(), dataType);
+    id = 2;
+    protoEncoder.visit(id, std::string(), std::string(), message);
+    id = 3;
+    cluon::data::TimeStamp timeStamp{sent};
+    protoEncoder.visit(id, std::string(), std::string(), timeStamp);
+    id        = 4;
+    timeStamp = cluon::data::TimeStamp();
+    protoEncoder.visit(id, std::string(), std::string(), timeStamp);
+    id        = 5;
+    timeStamp = sampleTimeStamp;
+    protoEncoder.visit(id, std::string(), std::string(), timeStamp);
+    id = 6;
+    protoEncoder.visit(id, std::string(), std::string(), senderStamp);
+
+    writeOD4Header(buffer);
+}
+
 /**
  * This method transforms a given Envelope to a string representation to be
  * sent to an OpenDaVINCI session.
@@ -8030,33 +9093,7 @@ namespace cluon {
  */
 inline std::string serializeEnvelope(cluon::data::Envelope &&envelope) noexcept {
     std::string dataToSend;
-    {
-        std::stringstream sstr;
-
-        cluon::ToProtoVisitor protoEncoder;
-        envelope.accept(protoEncoder);
-
-        const std::string tmp{protoEncoder.encodedData()};
-        uint32_t length{static_cast<uint32_t>(tmp.size())};
-        length <<= 8;
-        length = htole32(length);
-
-        // Add OD4 header.
-        constexpr unsigned char OD4_HEADER_BYTE0 = 0x0D;
-        constexpr unsigned char OD4_HEADER_BYTE1 = 0xA4;
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE0));
-        auto posByte1 = sstr.tellp();
-        sstr.write(reinterpret_cast<char *>(&length), static_cast<std::streamsize>(sizeof(uint32_t)));
-        auto posByte5 = sstr.tellp();
-        sstr.seekp(posByte1);
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE1));
-        sstr.seekp(posByte5);
-
-        // Write payload.
-        sstr.write(tmp.data(), static_cast<std::streamsize>(tmp.size()));
-
-        dataToSend = sstr.str();
-    }
+    serializeEnvelope(dataToSend, envelope);
     return dataToSend;
 }
 
@@ -8119,21 +9156,280 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
 }
 
 /**
- * @return Extract a given Envelope's payload into the desired type.
+ * This method extracts an Envelope from the given bytes in format:
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * The Envelope is decoded in place; only its fields are copied. As the number
+ * of consumed bytes is returned, this method can be used to walk through a
+ * sequence of Envelopes in memory, e.g., a datagram or an mmap'ed recording.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @return Pair: number of bytes consumed (0 if no complete Envelope was found), and cluon::data::Envelope.
+ */
+inline std::pair<std::size_t, cluon::data::Envelope> extractEnvelope(const char *data, std::size_t size) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    std::size_t consumed{0};
+    cluon::data::Envelope env;
+    if ((nullptr != data) && (OD4_HEADER_SIZE <= size) && (0x0D == static_cast<uint8_t>(data[0]))
+        && (0xA4 == static_cast<uint8_t>(data[1]))) {
+        const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2]))
+                                 | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                                 | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+        if (OD4_HEADER_SIZE + LENGTH <= size) {
+            cluon::FromProtoVisitor protoDecoder;
+            protoDecoder.decodeFrom(data + OD4_HEADER_SIZE, LENGTH, env);
+            consumed = OD4_HEADER_SIZE + LENGTH;
+        }
+    }
+    return std::make_pair(consumed, std::move(env));
+}
+
+/**
+ * This method reads the field dataType of an Envelope straight from the raw
+ * bytes in format
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * without decoding the Envelope. It allows to discard Envelopes that nobody
+ * is interested in before any memory is allocated for them.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @return Pair: true if the bytes are a complete Envelope, and its dataType.
+ */
+inline std::pair<bool, int32_t> peekEnvelopeDataType(const char *data, std::size_t size) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    if ((nullptr == data) || (OD4_HEADER_SIZE > size) || (0x0D != static_cast<uint8_t>(data[0]))
+        || (0xA4 != static_cast<uint8_t>(data[1]))) {
+        return std::make_pair(false, 0);
+    }
+    const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2]))
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+    if (OD4_HEADER_SIZE + LENGTH > size) {
+        return std::make_pair(false, 0);
+    }
+
+    const uint8_t *pos{reinterpret_cast<const uint8_t *>(data) + OD4_HEADER_SIZE};
+    const uint8_t *end{pos + LENGTH};
+    auto readVarInt = [&pos, end](uint64_t &value) {
+        value = 0;
+        for (uint8_t shift{0}; (pos < end) && (shift < 64); shift = static_cast<uint8_t>(shift + 7)) {
+            const uint8_t c{*pos++};
+            value |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if (0 == (c & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Fields that are not encoded have their default value.
+    int32_t dataType{0};
+    while (pos < end) {
+        uint64_t key{0};
+        if (!readVarInt(key)) {
+            return std::make_pair(false, 0);
+        }
+        const uint64_t FIELD_ID{key >> 3};
+        const uint8_t WIRE_TYPE{static_cast<uint8_t>(key & 0x7)};
+        uint64_t value{0};
+        if (static_cast<uint8_t>(ProtoConstants::VARINT) == WIRE_TYPE) {
+            if (!readVarInt(value)) {
+                return std::make_pair(false, 0);
+            }
+            if (1 == FIELD_ID) {
+                // dataType is ZigZag-encoded.
+                const uint32_t v{static_cast<uint32_t>(value)};
+                dataType = static_cast<int32_t>((v >> 1) ^ -(v & 1));
+                return std::make_pair(true, dataType);
+            }
+        } else if (static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED) == WIRE_TYPE) {
+            if (!readVarInt(value) || (value > static_cast<uint64_t>(end - pos))) {
+                return std::make_pair(false, 0);
+            }
+            pos += value;
+        } else if ((static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES) == WIRE_TYPE) && (8 <= end - pos)) {
+            pos += 8;
+        } else if ((static_cast<uint8_t>(ProtoConstants::FOUR_BYTES) == WIRE_TYPE) && (4 <= end - pos)) {
+            pos += 4;
+        } else {
+            return std::make_pair(false, 0);
+        }
+    }
+    return std::make_pair(pos == end, dataType);
+}
+
+/**
+ * This method locates the field serializedData of an Envelope in the raw
+ * bytes in format
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * without decoding or copying it. Together with the read-only views generated
+ * by cluon-msc --views, single fields of large messages can be read in place.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @return Pair: pointer to the payload within data (nullptr if the bytes are not a complete Envelope), and its size.
+ */
+inline std::pair<const char *, std::size_t> peekEnvelopeSerializedData(const char *data, std::size_t size) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    if ((nullptr == data) || (OD4_HEADER_SIZE > size) || (0x0D != static_cast<uint8_t>(data[0]))
+        || (0xA4 != static_cast<uint8_t>(data[1]))) {
+        return std::make_pair(nullptr, 0);
+    }
+    const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2]))
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+    if (OD4_HEADER_SIZE + LENGTH > size) {
+        return std::make_pair(nullptr, 0);
+    }
+
+    const char *pos{data + OD4_HEADER_SIZE};
+    const char *end{pos + LENGTH};
+    auto readVarInt = [&pos, end](uint64_t &value) {
+        value = 0;
+        for (uint8_t shift{0}; (pos < end) && (shift < 64); shift = static_cast<uint8_t>(shift + 7)) {
+            const uint8_t c{static_cast<uint8_t>(*pos++)};
+            value |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if (0 == (c & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Like a decoder, the last occurrence of the field counts; an Envelope
+    // without payload has an empty one.
+    std::pair<const char *, std::size_t> serializedData{end, 0};
+    while (pos < end) {
+        uint64_t key{0};
+        if (!readVarInt(key)) {
+            return std::make_pair(nullptr, 0);
+        }
+        const uint64_t FIELD_ID{key >> 3};
+        const uint8_t WIRE_TYPE{static_cast<uint8_t>(key & 0x7)};
+        uint64_t value{0};
+        if (static_cast<uint8_t>(ProtoConstants::VARINT) == WIRE_TYPE) {
+            if (!readVarInt(value)) {
+                return std::make_pair(nullptr, 0);
+            }
+        } else if (static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED) == WIRE_TYPE) {
+            if (!readVarInt(value) || (value > static_cast<uint64_t>(end - pos))) {
+                return std::make_pair(nullptr, 0);
+            }
+            if (2 == FIELD_ID) {
+                serializedData = std::make_pair(pos, static_cast<std::size_t>(value));
+            }
+            pos += value;
+        } else if ((static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES) == WIRE_TYPE) && (8 <= end - pos)) {
+            pos += 8;
+        } else if ((static_cast<uint8_t>(ProtoConstants::FOUR_BYTES) == WIRE_TYPE) && (4 <= end - pos)) {
+            pos += 4;
+        } else {
+            return std::make_pair(nullptr, 0);
+        }
+    }
+    return serializedData;
+}
+
+/**
+ * This method reads the field senderStamp of an Envelope straight from the
+ * raw bytes in format
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * without decoding the Envelope. Together with its dataType, it identifies
+ * the stream an Envelope belongs to.
+ *
+ * @param data Pointer to the bytes to read from.
+ * @param size Number of bytes available at data.
+ * @return Pair: true if the bytes are a complete Envelope, and its senderStamp.
+ */
+inline std::pair<bool, uint32_t> peekEnvelopeSenderStamp(const char *data, std::size_t size) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    if ((nullptr == data) || (OD4_HEADER_SIZE > size) || (0x0D != static_cast<uint8_t>(data[0]))
+        || (0xA4 != static_cast<uint8_t>(data[1]))) {
+        return std::make_pair(false, 0);
+    }
+    const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2]))
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+    if (OD4_HEADER_SIZE + LENGTH > size) {
+        return std::make_pair(false, 0);
+    }
+
+    const uint8_t *pos{reinterpret_cast<const uint8_t *>(data) + OD4_HEADER_SIZE};
+    const uint8_t *end{pos + LENGTH};
+    auto readVarInt = [&pos, end](uint64_t &value) {
+        value = 0;
+        for (uint8_t shift{0}; (pos < end) && (shift < 64); shift = static_cast<uint8_t>(shift + 7)) {
+            const uint8_t c{*pos++};
+            value |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if (0 == (c & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // The senderStamp is encoded last; like a decoder, the last occurrence counts.
+    uint32_t senderStamp{0};
+    while (pos < end) {
+        uint64_t key{0};
+        if (!readVarInt(key)) {
+            return std::make_pair(false, 0);
+        }
+        const uint64_t FIELD_ID{key >> 3};
+        const uint8_t WIRE_TYPE{static_cast<uint8_t>(key & 0x7)};
+        uint64_t value{0};
+        if (static_cast<uint8_t>(ProtoConstants::VARINT) == WIRE_TYPE) {
+            if (!readVarInt(value)) {
+                return std::make_pair(false, 0);
+            }
+            if (6 == FIELD_ID) {
+                senderStamp = static_cast<uint32_t>(value);
+            }
+        } else if (static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED) == WIRE_TYPE) {
+            if (!readVarInt(value) || (value > static_cast<uint64_t>(end - pos))) {
+                return std::make_pair(false, 0);
+            }
+            pos += value;
+        } else if ((static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES) == WIRE_TYPE) && (8 <= end - pos)) {
+            pos += 8;
+        } else if ((static_cast<uint8_t>(ProtoConstants::FOUR_BYTES) == WIRE_TYPE) && (4 <= end - pos)) {
+            pos += 4;
+        } else {
+            return std::make_pair(false, 0);
+        }
+    }
+    return std::make_pair(true, senderStamp);
+}
+
+/**
+ * @return Extract the given Proto-encoded bytes into the desired type.
  */
 template <typename T>
-inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
+inline T extractMessage(const char *data, std::size_t size) noexcept {
     cluon::FromProtoVisitor decoder;
 
-    std::stringstream sstr(envelope.serializedData());
-    decoder.decodeFrom(sstr);
-
     T msg;
-    msg.accept(decoder);
+    decoder.decodeFrom(data, size, msg);
 
     return msg;
 }
 
+/**
+ * @return Extract a given Envelope's payload into the desired type.
+ */
+template <typename T>
+inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
+    return extractMessage<T>(envelope.serializedData().data(), envelope.serializedData().size());
+}
+
 } // namespace cluon
 
 #endif
@@ -8846,41 +10142,311 @@ class LIBCLUON_API LCMToGenericMessage {
 } // namespace cluon
 #endif
 /*
- * Copyright (C) 2017-2018  Christian Berger
+ * Copyright (C) 2021  Group 17
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
-#ifndef CLUON_OD4SESSION_HPP
-#define CLUON_OD4SESSION_HPP
+#ifndef CLUON_LOCALTRANSPORT_HPP
+#define CLUON_LOCALTRANSPORT_HPP
 
-//#include "cluon/Time.hpp"
-//#include "cluon/ToProtoVisitor.hpp"
-//#include "cluon/UDPReceiver.hpp"
-//#include "cluon/UDPSender.hpp"
+//#include "cluon/NotifyingPipeline.hpp"
 //#include "cluon/cluon.hpp"
-//#include "cluon/cluonDataStructures.hpp"
 
+// clang-format off
+#ifdef WIN32
+    #include <Winsock2.h> // for WSAStartUp
+    #include <ws2tcpip.h> // for SOCKET
+#else
+    #include <netinet/in.h>
+#endif
+// clang-format on
+
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
-#include <unordered_map>
-#include <utility>
+#include <thread>
+#include <vector>
 
 namespace cluon {
 /**
-This class provides an interface to an OpenDaVINCI v4 session. An OpenDaVINCI
-v4 session allows the automatic exchange of time-stamped Envelopes carrying
-user-defined messages usually using UDP multicast. A running OD4Session will not
-receive the bytes that itself has sent to other microservices.
+LocalTransport exchanges the datagrams of an OD4 session between the
+OD4Sessions on the same host through a ring buffer in shared memory
+(/dev/shm/cluon-od4-<CID>) instead of the UDP multicast loopback.
+
+Every OD4Session of a CID appends the datagrams it sends to the ring and a
+thread per OD4Session copies the datagrams of all other OD4Sessions from it
+into a bounded NotifyingPipeline, whose thread calls the delegate, like
+UDPReceiver; thus, a slow delegate does not hold up reading the ring. The
+readers sleep on a futex in the shared memory that the writers wake after
+every datagram, and publish how far they have read. A writer that would
+overwrite datagrams that an attached reader has not read yet waits for that
+reader, but at most 100 ms per reader and read position, so that a stopped
+or overloaded reader cannot stall the whole session; such a reader loses the
+overwritten datagrams, like a full UDP receive buffer, and counts an overrun.
+
+The attached OD4Sessions claim a slot in the shared memory with a token of
+their process ID and start time, and register their UDP send port and the
+inode of their UDP receive socket there. The reading thread holds a robust
+mutex of its slot for as long as it is attached; thus, the slot of a process
+that died is recognized right away without any heartbeat. Datagrams that
+arrive via UDP from the send port of an attached OD4Session are duplicates of
+the ring's datagrams. The last OD4Session to detach removes the shared memory.
+
+While an OD4Session sends, a thread of its own looks up at most once a second
+whether every socket on this host that receives the session's multicast group
+is read by an attached OD4Session; only then multicast loopback is turned off.
+Processes in another IPC namespace or built with an older libcluon keep
+receiving the multicast loopback. The look-up parses /proc/net/udp, which
+costs in the order of 100 us per second of sending; an idle OD4Session does
+not look up anything and none of its threads wakes up.
+
+LocalTransport is only available on Linux; setting the environment variable
+CLUON_OD4_SHM=0 disables it.
+*/
+class LIBCLUON_API LocalTransport {
+   private:
+    LocalTransport(const LocalTransport &) = delete;
+    LocalTransport(LocalTransport &&)      = delete;
+    LocalTransport &operator=(const LocalTransport &) = delete;
+    LocalTransport &operator=(LocalTransport &&) = delete;
 
-There are two ways to participate in an OpenDaVINCI session. Variant A is simply
-calling a user-supplied lambda whenever a new Envelope is received:
+   public:
+    /**
+     * Constructor.
+     *
+     * @param CID OpenDaVINCI v4 session identifier [1 .. 254]
+     * @param sendFromPort UDP port that the OD4Session sends from; it identifies the datagrams of this OD4Session.
+     * @param delegate Function to call with every datagram from another OD4Session on this host;
+     *        parameters are the bytes, the UDP send port of the sender, and the receive time stamp.
+     */
+    LocalTransport(uint16_t CID,
+                   uint16_t sendFromPort,
+                   std::function<void(const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point)> delegate) noexcept;
+    ~LocalTransport() noexcept;
+
+    /**
+     * @return true if the shared memory is attached and datagrams are exchanged through it.
+     */
+    bool isRunning() const noexcept;
+
+    /**
+     * This method registers the UDP socket that receives this OD4Session's
+     * multicast group so that senders know that it reads the shared memory.
+     *
+     * @param socketInode Inode of the UDP receive socket as listed in /proc/net/udp.
+     */
+    void registerReceiveSocket(uint64_t socketInode) noexcept;
+
+    /**
+     * This method appends a datagram to the ring and wakes the readers.
+     *
+     * @param data Pointer to the bytes to send.
+     * @param size Number of bytes to send.
+     * @return true if the datagram was appended.
+     */
+    bool send(const char *data, std::size_t size) noexcept;
+
+    /**
+     * This method is meant to be called before sending; it requests to look
+     * up the receivers on this host again if the last look-up is older than
+     * a second, which happens in the background.
+     *
+     * @return true if every socket on this host that receives the multicast
+     *         group is read by an attached OD4Session, i.e., the multicast
+     *         loopback is not needed; false until /proc/net/udp was read
+     *         successfully and while the last look-up is older than two seconds.
+     */
+    bool allLocalReceiversAttached() noexcept;
+
+    /**
+     * @return true if the given sender is an OD4Session on this host that has claimed a slot in the
+     *         shared memory and is still running, i.e., its datagrams arrive through the ring.
+     */
+    bool isAttachedSender(const struct sockaddr_in &sender) const noexcept;
+
+    /**
+     * @return Number of datagrams received through the shared memory so far.
+     */
+    uint64_t numberOfReceivedDatagrams() const noexcept;
+
+    /**
+     * @return Number of times this reader fell behind by more than the ring's capacity and skipped the overwritten datagrams.
+     */
+    uint64_t numberOfOverruns() const noexcept;
+
+    /**
+     * @return Number of times a writer gave up waiting for a reader that lagged behind by the ring's capacity.
+     */
+    uint64_t numberOfBackpressureTimeouts() const noexcept;
+
+   private:
+    // Opens, maps, and initializes the shared memory; retry is set when it was removed by its last OD4Session meanwhile.
+    bool mapSharedMemory(bool &retry) noexcept;
+    void unmapSharedMemory() noexcept;
+    // Locks the writers' mutex of all processes; m_header must be mapped.
+    bool lockWriterMutex() noexcept;
+    // Claims a free slot from the reading thread, which holds its m_alive from now on; the writers' mutex must be locked.
+    bool claimSlot() noexcept;
+    // Releases the slot from the reading thread and removes the shared memory if no other OD4Session is attached.
+    void releaseSlot() noexcept;
+    // Checks whether the slot is claimed by a running OD4Session; the slot of an owner that died is freed.
+    bool isAttached(std::size_t slot) const noexcept;
+    // Waits for the attached readers that would lose datagrams when the ring is written up to end; the writers' mutex must be locked.
+    void waitForReaders(uint64_t end) noexcept;
+    // Buffers for the datagrams in the pipeline are recycled between the reading thread and the pipeline's thread.
+    std::vector<char> acquireBuffer() noexcept;
+    void releaseBuffer(std::vector<char> &&buffer) noexcept;
+    // Parses /proc/net/udp for sockets receiving the multicast group that no attached OD4Session reads.
+    bool checkLocalReceivers() const noexcept;
+    void watchLocalReceivers() noexcept;
+    void readFromRing() noexcept;
+
+   private:
+    struct Header;
+    // Outcome of claiming a slot in the reading thread.
+    enum class Claim : uint8_t { PENDING, CLAIMED, FAILED, REMOVED };
+
+    uint16_t m_sendFromPort;
+    // Identifies this OD4Session's slot: process ID and start time.
+    uint64_t m_owner{0};
+    std::atomic<uint64_t> m_socketInode{0};
+    std::string m_groupAddressInProcNetUDP{};
+    std::function<void(const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point)> m_delegate;
+    std::set<unsigned long> m_listOfLocalIPAddresses{};
+
+    std::string m_name{};
+    int32_t m_fd{-1};
+    std::size_t m_mappedSize{0};
+    char *m_sharedMemory{nullptr};
+    Header *m_header{nullptr};
+    char *m_ring{nullptr};
+    std::size_t m_slot{0};
+
+    std::atomic<Claim> m_claim{Claim::PENDING};
+    std::atomic<bool> m_readFromRingThreadRunning{false};
+    std::thread m_readFromRingThread{};
+
+    // The receivers on this host are only looked up on request while sending.
+    std::atomic<bool> m_watchThreadRunning{false};
+    std::thread m_watchThread{};
+    std::mutex m_watchMutex{};
+    std::condition_variable m_watchCondition{};
+    bool m_checkRequested{false};
+    std::atomic<int64_t> m_lastCheckRequest{0};
+    std::atomic<int64_t> m_lastCheck{0};
+    std::atomic<bool> m_allLocalReceiversAttached{false};
+
+    // Read positions at which a writer gave up waiting for the readers; guarded by the writers' mutex.
+    std::vector<uint64_t> m_laggingReaders{};
+
+    std::atomic<uint64_t> m_numberOfReceivedDatagrams{0};
+    std::atomic<uint64_t> m_numberOfOverruns{0};
+    std::atomic<uint64_t> m_numberOfBackpressureTimeouts{0};
+
+    class PipelineEntry {
+       public:
+        std::vector<char> m_data{};
+        uint16_t m_sendFromPort{0};
+        std::chrono::system_clock::time_point m_sampleTime{};
+    };
+    std::unique_ptr<NotifyingPipeline<PipelineEntry>> m_pipeline{};
+    static constexpr std::size_t MAX_POOLED_BUFFERS{64};
+    std::mutex m_bufferPoolMutex{};
+    std::vector<std::vector<char>> m_bufferPool{};
+};
+} // namespace cluon
+
+#endif
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_OD4SESSION_HPP
+#define CLUON_OD4SESSION_HPP
+
+//#include "cluon/LocalTransport.hpp"
+//#include "cluon/Time.hpp"
+//#include "cluon/ToProtoVisitor.hpp"
+//#include "cluon/UDPReceiver.hpp"
+//#include "cluon/UDPSender.hpp"
+//#include "cluon/cluon.hpp"
+//#include "cluon/cluonDataStructures.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cluon {
+
+/**
+Defines what OD4Session::timeTrigger does when the delegate overran its period.
+*/
+enum class OverrunPolicy : uint8_t {
+    SKIP     = 0, // Skip the missed activations and continue at the next deadline in the future.
+    CATCH_UP = 1, // Call the delegate back to back until all missed activations are made up for.
+};
+
+/**
+Activation statistics of OD4Session::timeTrigger.
+*/
+class LIBCLUON_API TimeTriggerStatistics {
+   public:
+    uint64_t m_numberOfActivations{0};
+    // Activations that ended after the next deadline.
+    uint64_t m_numberOfOverruns{0};
+    // Activations that were skipped due to OverrunPolicy::SKIP.
+    uint64_t m_numberOfSkippedActivations{0};
+    // Delay from an activation's deadline until the delegate was called.
+    int64_t m_meanJitterInNanoseconds{0};
+    int64_t m_maxJitterInNanoseconds{0};
+};
+
+/**
+Statistics of a decode worker of OD4Session::decodeWorkers.
+*/
+class LIBCLUON_API DecodeWorkerStatistics {
+   public:
+    // Envelopes waiting for the worker and the highest number waiting at the same time.
+    std::size_t m_queueDepth{0};
+    std::size_t m_queueHighWaterMark{0};
+    uint64_t m_numberOfDispatchedEnvelopes{0};
+    // Envelopes discarded as the worker's queue was full.
+    uint64_t m_numberOfDroppedEnvelopes{0};
+    // Time spent decoding and dispatching; with m_numberOfDispatchedEnvelopes, this gives the worker's throughput.
+    int64_t m_busyTimeInNanoseconds{0};
+};
+
+/**
+This class provides an interface to an OpenDaVINCI v4 session. An OpenDaVINCI
+v4 session allows the automatic exchange of time-stamped Envelopes carrying
+user-defined messages usually using UDP multicast. A running OD4Session will not
+receive the bytes that itself has sent to other microservices.
+
+There are two ways to participate in an OpenDaVINCI session. Variant A is simply
+calling a user-supplied lambda whenever a new Envelope is received:
 
 \code{.cpp}
 cluon::OD4Session od4{111, [](cluon::data::Envelope &&envelope){ std::cout << "Received cluon::Envelope" << std::endl;}
@@ -8919,6 +10485,42 @@ od4.timeTrigger(FREQ, [](){
   return false;
 }); // This call blocks until the lambda returns false.
 \endcode
+
+The lambda is called at absolute deadlines on a monotonic clock; thus, the
+frequency does not drift with the lambda's execution time and is not affected
+by adjustments of the wall clock. When the lambda overruns its period, the
+OverrunPolicy decides whether the missed activations are skipped or made up
+for; timeTriggerStatistics() reports the overruns and the activation jitter.
+
+All Envelopes are decoded and dispatched one after another in the thread that
+receives them. Envelopes of latency-critical messages can be routed to a
+dispatch lane of their own to not wait behind bulk traffic like images:
+
+\code{.cpp}
+cluon::OD4Session od4{111};
+od4.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), [](cluon::data::Envelope &&envelope){ });
+
+// Dispatch GroundSteeringRequests in a thread of their own with real-time priority 10.
+od4.dispatchLane({opendlv::proxy::GroundSteeringRequest::ID()}, 64, cluon::OverflowPolicy::DROP_OLDEST, 10);
+\endcode
+
+When one thread cannot decode all Envelopes, e.g., when subscribing to
+everything for logging, the remaining Envelopes can be spread over a pool
+of decode workers; each stream, i.e., dataType and senderStamp, is
+dispatched in order by one worker:
+
+\code{.cpp}
+// The delegate is called from four threads in parallel.
+cluon::OD4Session od4{111, [](cluon::data::Envelope &&envelope){ }};
+od4.decodeWorkers(4);
+\endcode
+
+On Linux, OD4Sessions of the same CID on one host exchange their Envelopes
+through shared memory (see LocalTransport) instead of the UDP multicast
+loopback; Envelopes from other hosts are still received via UDP multicast.
+The multicast loopback is turned off while every local receiver of the
+multicast group is an OD4Session reading the shared memory. Setting the
+environment variable CLUON_OD4_SHM=0 disables the shared memory.
 */
 class LIBCLUON_API OD4Session {
    private:
@@ -8938,6 +10540,7 @@ class LIBCLUON_API OD4Session {
      *        to have both: a delegate for "catch-all" and the data-triggered ones.
      */
     OD4Session(uint16_t CID, std::function<void(cluon::data::Envelope &&envelope)> delegate = nullptr) noexcept;
+    ~OD4Session() noexcept;
 
     /**
      * This method will send a given Envelope to this OpenDaVINCI v4 session.
@@ -8946,6 +10549,47 @@ class LIBCLUON_API OD4Session {
      */
     void send(cluon::data::Envelope &&envelope) noexcept;
 
+    /**
+     * This method enables or disables batched sending: while enabled, send
+     * only queues the encoded Envelopes and flush sends all queued Envelopes
+     * with as few system calls as possible (one sendmmsg per batch on Linux).
+     * Disabling batched sending flushes the queued Envelopes.
+     *
+     * @param enable true to queue the Envelopes until the next flush.
+     * @param autoFlush If true, timeTrigger flushes after every activation of its delegate.
+     */
+    void batchSends(bool enable, bool autoFlush = true) noexcept;
+
+    /**
+     * This method sends all Envelopes queued by batched sending.
+     */
+    void flush() noexcept;
+
+    /**
+     * This method enables or disables packing: while batched sending is
+     * enabled, consecutive Envelopes are packed back to back into datagrams
+     * of up to the given size; larger Envelopes are still sent on their own.
+     * Receiving OD4Sessions always split packed datagrams into their Envelopes.
+     * Peers using a libcluon without this support decode only the first
+     * Envelope of a packed datagram; thus, packing must only be enabled when
+     * all receivers of this OD4 session split packed datagrams.
+     *
+     * @param maximumDatagramSize Maximum size of a packed datagram in bytes;
+     *        the default fills an Ethernet MTU of 1500 bytes; 0 disables packing.
+     */
+    void packEnvelopes(std::size_t maximumDatagramSize = 1472) noexcept;
+
+    /**
+     * This method limits the reassembly of Envelopes that do not fit into one
+     * UDP datagram and are thus sent in fragments: an incomplete Envelope is
+     * discarded when its fragments did not all arrive within the timeout or,
+     * oldest first, when the incomplete Envelopes would need more memory.
+     *
+     * @param maximumMemory Maximum number of bytes for incomplete Envelopes (default: 64 MB).
+     * @param timeout Maximum time between the first and the last fragment of an Envelope (default: 1 s).
+     */
+    void reassemblyLimits(std::size_t maximumMemory, std::chrono::milliseconds timeout) noexcept;
+
     /**
      * This method sets a delegate to be called data-triggered on arrival
      * of a new Envelope for a given message identifier.
@@ -8956,6 +10600,72 @@ class LIBCLUON_API OD4Session {
      */
     bool dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept;
 
+    /**
+     * This method sets a data-triggered delegate that decodes each arriving
+     * message of type T and stores it with its received time stamp in the
+     * given LatestValue; any thread can then sample it without blocking.
+     * With decodeWorkers, messages of type T from different senderStamps are
+     * decoded in parallel; their stores are serialized by a mutex of the
+     * delegate as LatestValue must only be stored to by one thread at a time.
+     *
+     * @param latestValue LatestValue to update; it must outlive this OD4Session
+     *        and must not be stored to by anything else.
+     * @return true if the delegate could be set.
+     */
+    template <typename T>
+    bool keepLatest(LatestValue<T> &latestValue) noexcept {
+        auto storeMutex = std::make_shared<std::mutex>();
+        return dataTrigger(static_cast<int32_t>(T::ID()), [&latestValue, storeMutex](cluon::data::Envelope &&envelope) {
+            const cluon::data::TimeStamp RECEIVED{envelope.received()};
+            const T VALUE{cluon::extractMessage<T>(std::move(envelope))};
+            std::lock_guard<std::mutex> lck{*storeMutex};
+            latestValue.store(VALUE, RECEIVED);
+        });
+    }
+
+    /**
+     * This method routes Envelopes with the given message identifiers to a
+     * dispatch lane of their own: a bounded queue and a thread that decodes
+     * the Envelopes and calls their delegate. The receiving thread only peeks
+     * at their dataType and hands them over. All other Envelopes are still
+     * dispatched from the receiving thread; routing bulk traffic to a lane of
+     * its own, too, keeps the delay of the latency-critical lanes bounded.
+     *
+     * @param messageIdentifiers Message identifiers to route to the new lane;
+     *        a message identifier that was routed before is moved to the new lane.
+     * @param queueCapacity Maximum number of Envelopes waiting in the lane.
+     * @param overflowPolicy What to do with Envelopes arriving at a full lane.
+     * @param priority Real-time priority (SCHED_FIFO) for the lane's thread; 0 keeps the default scheduling.
+     * @return true if the lane was created; a priority that could not be set is reported but does not fail.
+     */
+    bool dispatchLane(const std::vector<int32_t> &messageIdentifiers,
+                      std::size_t queueCapacity     = 64,
+                      OverflowPolicy overflowPolicy = OverflowPolicy::DROP_OLDEST,
+                      int32_t priority              = 0) noexcept;
+
+    /**
+     * This method spreads decoding and dispatching of the Envelopes that are
+     * not routed to a dispatch lane over a pool of worker threads, each with
+     * a bounded queue; the receiving thread only peeks at their dataType and
+     * senderStamp and hands them over. All Envelopes of the same dataType and
+     * senderStamp go to the same worker; thus, each stream is dispatched in
+     * order while different streams are dispatched in parallel. Hence, the
+     * delegates must be thread-safe; those set by keepLatest() are.
+     *
+     * @param numberOfWorkers Number of worker threads; 0 dispatches in the receiving thread again.
+     * @param queueCapacity Maximum number of Envelopes waiting per worker.
+     * @param overflowPolicy What to do with Envelopes arriving at a full worker.
+     * @return true if the workers were created.
+     */
+    bool decodeWorkers(std::size_t numberOfWorkers,
+                       std::size_t queueCapacity     = 1024,
+                       OverflowPolicy overflowPolicy = OverflowPolicy::DROP_OLDEST) noexcept;
+
+    /**
+     * @return Statistics of the current decode workers, one entry per worker.
+     */
+    std::vector<DecodeWorkerStatistics> decodeWorkerStatistics() const noexcept;
+
     /**
      * This method sets a delegate to be called time-triggered using the
      * specified frequency until the delegate returns false. This method
@@ -8965,11 +10675,20 @@ class LIBCLUON_API OD4Session {
      *
      * @param freq Frequency in Hertz to run the given delegate.
      * @param delegate Function to call according to the given frequency.
+     * @param overrunPolicy What to do with activations missed as the delegate overran its period.
      */
-    void timeTrigger(float freq, std::function<bool()> delegate) noexcept;
+    void timeTrigger(float freq, std::function<bool()> delegate, OverrunPolicy overrunPolicy = OverrunPolicy::SKIP) noexcept;
+
+    /**
+     * @return Activation statistics of the currently or last running timeTrigger.
+     */
+    TimeTriggerStatistics timeTriggerStatistics() const noexcept;
 
     /**
      * This method will send a given message to this OpenDaVINCI v4 session.
+     * Envelopes larger than a UDP datagram are sent in fragments that the
+     * receiving OD4Sessions reassemble before their delegates are called;
+     * Envelopes larger than the OD4 header's limit of 16 MB are not sent.
      *
      * @param message Message to be sent.
      * @param sampleTimeStamp Time point when this sample to be sent was captured (default = sent time point).
@@ -8979,39 +10698,227 @@ class LIBCLUON_API OD4Session {
     void send(T &message, const cluon::data::TimeStamp &sampleTimeStamp = cluon::data::TimeStamp(), uint32_t senderStamp = 0) noexcept {
         try {
             std::lock_guard<std::mutex> lck(m_senderMutex);
-            cluon::ToProtoVisitor protoEncoder;
-
-            cluon::data::Envelope envelope;
-            {
-                envelope.dataType(static_cast<int32_t>(message.ID()));
-                message.accept(protoEncoder);
-                envelope.serializedData(protoEncoder.encodedData());
-                envelope.sent(cluon::time::now());
-                envelope.sampleTimeStamp((0 == (sampleTimeStamp.seconds() + sampleTimeStamp.microseconds())) ? envelope.sent() : sampleTimeStamp);
-                envelope.senderStamp(senderStamp);
-            }
-
-            send(std::move(envelope));
+            const cluon::data::TimeStamp SENT{cluon::time::now()};
+            // The message is encoded into the Envelope in the reused send buffer.
+            cluon::serializeEnvelope(m_sendBuffer,
+                                     message,
+                                     SENT,
+                                     (0 == (sampleTimeStamp.seconds() + sampleTimeStamp.microseconds())) ? SENT : sampleTimeStamp,
+                                     senderStamp);
+            sendEncoded(m_sendBuffer.data(), m_sendBuffer.size());
         } catch (...) {} // LCOV_EXCL_LINE
     }
 
    public:
     bool isRunning() noexcept;
 
+    /**
+     * @return Number of Envelopes that were discarded without decoding them
+     *         as no data-triggered delegate was registered for their dataType.
+     */
+    uint64_t numberOfFilteredEnvelopes() const noexcept;
+
+    /**
+     * @return Number of Envelopes sent or queued for sending so far.
+     */
+    uint64_t numberOfSentEnvelopes() const noexcept;
+
+    /**
+     * @return Number of datagrams sent so far; with packing, a datagram
+     *         carries several Envelopes.
+     */
+    uint64_t numberOfSentDatagrams() const noexcept;
+
+    /**
+     * @return Number of send system calls issued so far; together with
+     *         numberOfSentDatagrams, this gives the datagrams per system call.
+     */
+    uint64_t numberOfSendCalls() const noexcept;
+
+    /**
+     * @return Number of Envelopes that were received in fragments and reassembled.
+     */
+    uint64_t numberOfReassembledEnvelopes() const noexcept;
+
+    /**
+     * @return Number of incomplete Envelopes discarded due to the limits of the reassembly.
+     */
+    uint64_t numberOfDroppedReassemblies() const noexcept;
+
+    /**
+     * @return Number of times this session fell behind the other sessions on
+     *         this host by the shared memory's capacity and lost datagrams.
+     */
+    uint64_t numberOfSharedMemoryOverruns() const noexcept;
+
+    /**
+     * @return Number of times this session gave up waiting for another
+     *         session on this host that fell behind by the shared memory's capacity.
+     */
+    uint64_t numberOfSharedMemoryBackpressureTimeouts() const noexcept;
+
    private:
-    void callback(std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) noexcept;
+    void callback(const cluon::UDPDatagram &datagram) noexcept;
+    void route(const char *data, std::size_t size, const std::chrono::system_clock::time_point &sampleTime) noexcept;
+    void reassemble(const cluon::UDPDatagram &datagram) noexcept;
+    // Sends, queues, or packs an encoded Envelope; m_senderMutex must be locked.
+    std::pair<ssize_t, int32_t> sendEncoded(const char *data, std::size_t size) noexcept;
+    // Sends or queues an encoded Envelope in fragments; m_senderMutex must be locked.
+    std::pair<ssize_t, int32_t> sendFragments(const char *data, std::size_t size, bool queue) noexcept;
+    // Sends or queues a datagram to the multicast group and the shared memory; m_senderMutex must be locked.
+    std::pair<ssize_t, int32_t> sendDatagram(const char *data, std::size_t size, bool queue) noexcept;
+    void dispatch(const char *data, std::size_t size, const std::chrono::system_clock::time_point &sampleTime) noexcept;
     void sendInternal(std::string &&dataToSend) noexcept;
 
    private:
     std::unique_ptr<cluon::UDPReceiver> m_receiver;
     cluon::UDPSender m_sender;
+    // Datagrams to and from OD4Sessions on this host; nullptr if shared memory is not available.
+    std::unique_ptr<cluon::LocalTransport> m_localTransport{nullptr};
+    // Serializes callback between the UDP and the shared memory receiving threads.
+    std::mutex m_callbackMutex{};
 
     std::mutex m_senderMutex{};
+    // Buffer to encode messages into; guarded by m_senderMutex.
+    std::string m_sendBuffer{};
+    // Batched sending: queue Envelopes until flush and flush after every timeTrigger activation.
+    std::atomic<bool> m_batchSends{false};
+    std::atomic<bool> m_flushAfterTimeTrigger{false};
+    // Packing: Envelopes collected for the next datagram and its maximum size; guarded by m_senderMutex.
+    std::string m_packBuffer{};
+    std::size_t m_maximumPackedDatagramSize{0};
+    std::atomic<uint64_t> m_numberOfSentEnvelopes{0};
+    // Whether the multicast loopback is enabled on the sender's socket; guarded by m_senderMutex.
+    bool m_multicastLoopback{true};
+
+    // A datagram carrying a fragment of an Envelope starts with 0x0D 0xA5 followed by the
+    // sequence identifier of the Envelope (uint32), the fragment's index and the number of
+    // fragments (uint16 each), and the size of the Envelope (uint32), all little endian.
+    static constexpr std::size_t FRAGMENT_HEADER_SIZE{14};
+    // The OD4 header stores an Envelope's length in 24 bits.
+    static constexpr std::size_t MAX_ENVELOPE_SIZE{5 + 0xFFFFFF};
+    // Fragmentation: sequence identifier of the next fragmented Envelope and the buffer to
+    // assemble a fragment in; guarded by m_senderMutex.
+    uint32_t m_nextSequenceIdentifier{0};
+    std::string m_fragmentBuffer{};
+
+    // Envelope being reassembled from its fragments.
+    class Reassembly {
+       public:
+        std::vector<char> m_data{};
+        std::vector<bool> m_hasFragment{};
+        std::size_t m_missingFragments{0};
+        std::chrono::steady_clock::time_point m_started{};
+    };
+    // Incomplete Envelopes by sender (IPv4 address and port) and sequence identifier, and
+    // the memory they hold; only accessed from callback.
+    std::map<std::pair<uint64_t, uint32_t>, Reassembly> m_reassemblies{};
+    std::size_t m_reassemblyMemory{0};
+    // Recently discarded Envelopes whose late fragments are ignored; only accessed from callback.
+    std::deque<std::pair<uint64_t, uint32_t>> m_discardedReassemblies{};
+    std::atomic<std::size_t> m_maximumReassemblyMemory{64 * 1024 * 1024};
+    std::atomic<int64_t> m_reassemblyTimeoutInMilliseconds{1000};
+    std::atomic<uint64_t> m_numberOfReassembledEnvelopes{0};
+    std::atomic<uint64_t> m_numberOfDroppedReassemblies{0};
 
     std::function<void(cluon::data::Envelope &&envelope)> m_delegate{nullptr};
 
-    std::mutex m_mapOfDataTriggeredDelegatesMutex{};
-    std::unordered_map<int32_t, std::function<void(cluon::data::Envelope &&envelope)>, UseUInt32ValueAsHashKey> m_mapOfDataTriggeredDelegates{};
+    // Immutable value that is replaced as a whole on every change (copy-on-write)
+    // and read through a plain atomic pointer: readers neither lock nor count
+    // references, and a slow reader never blocks an update. The mutex only
+    // serializes the updates. A replaced value is retired and kept until
+    // reclaim() is called at a point where no reader can still use it or, at
+    // the latest, until destruction.
+    template <typename T>
+    class Snapshot {
+       private:
+        Snapshot(const Snapshot &) = delete;
+        Snapshot(Snapshot &&)      = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+        Snapshot &operator=(Snapshot &&) = delete;
+
+       public:
+        Snapshot()  = default;
+        ~Snapshot() = default;
+
+        const T &get() const noexcept {
+            return *m_current.load(std::memory_order_acquire);
+        }
+
+        // Publishes a modified copy of the current value.
+        template <typename Modify>
+        void update(Modify &&modify) {
+            std::lock_guard<std::mutex> lck{m_mutex};
+            std::unique_ptr<T> next{new T(*m_latest)};
+            modify(*next);
+            m_retired.push_back(std::move(m_latest));
+            m_latest.reset(next.release());
+            m_current.store(m_latest.get(), std::memory_order_release);
+            m_hasRetired.store(true, std::memory_order_relaxed);
+        }
+
+        // Reads the current value while no retired value can be reclaimed.
+        template <typename Inspect>
+        void inspect(Inspect &&inspect) const {
+            std::lock_guard<std::mutex> lck{m_mutex};
+            inspect(*m_latest);
+        }
+
+        // Deletes the retired values; no reader must be using one of them.
+        void reclaim() noexcept {
+            if (m_hasRetired.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lck{m_mutex};
+                m_retired.clear();
+                m_hasRetired.store(false, std::memory_order_relaxed);
+            }
+        }
+
+       private:
+        mutable std::mutex m_mutex{};
+        std::unique_ptr<const T> m_latest{new T()};
+        std::atomic<const T *> m_current{m_latest.get()};
+        std::vector<std::unique_ptr<const T>> m_retired{};
+        std::atomic<bool> m_hasRetired{false};
+    };
+
+    // Data-triggered delegates; dispatching never waits for dataTrigger and vice versa.
+    // As they are read from the receiving threads, the dispatch lanes, and the decode
+    // workers, replaced maps are never reclaimed: each call to dataTrigger keeps one
+    // copy of the map until this OD4Session is destroyed.
+    using MapOfDataTriggeredDelegates = std::unordered_map<int32_t, std::function<void(cluon::data::Envelope &&envelope)>, UseUInt32ValueAsHashKey>;
+    Snapshot<MapOfDataTriggeredDelegates> m_mapOfDataTriggeredDelegates{};
+
+    std::atomic<uint64_t> m_numberOfFilteredEnvelopes{0};
+
+    // Activation statistics of timeTrigger; written by its thread only.
+    std::atomic<uint64_t> m_timeTriggerActivations{0};
+    std::atomic<uint64_t> m_timeTriggerOverruns{0};
+    std::atomic<uint64_t> m_timeTriggerSkippedActivations{0};
+    std::atomic<int64_t> m_timeTriggerJitterSumInNanoseconds{0};
+    std::atomic<int64_t> m_timeTriggerMaxJitterInNanoseconds{0};
+
+    // Envelope handed to a dispatch lane.
+    class LaneEntry {
+       public:
+        std::vector<char> m_data{};
+        std::chrono::system_clock::time_point m_sampleTime{};
+    };
+    using DispatchLane       = NotifyingPipeline<LaneEntry>;
+    using MapOfDispatchLanes = std::unordered_map<int32_t, std::shared_ptr<DispatchLane>, UseUInt32ValueAsHashKey>;
+    // Routing of message identifiers to dispatch lanes; only read by route, which runs
+    // under m_callbackMutex. Thus, replaced maps are reclaimed at the next callback.
+    Snapshot<MapOfDispatchLanes> m_mapOfDispatchLanes{};
+
+    // Decode worker; its pipeline is destroyed first as its thread updates the counters.
+    class DecodeWorker {
+       public:
+        std::atomic<uint64_t> m_numberOfDispatchedEnvelopes{0};
+        std::atomic<int64_t> m_busyTimeInNanoseconds{0};
+        std::unique_ptr<DispatchLane> m_pipeline{};
+    };
+    using DecodeWorkers = std::vector<std::shared_ptr<DecodeWorker>>;
+    // Pool of decode workers; reclaimed like the dispatch lanes above.
+    Snapshot<DecodeWorkers> m_decodeWorkers{};
 };
 
 } // namespace cluon
@@ -9939,6 +11846,147 @@ inline TerminateHandler::TerminateHandler() noexcept {
 #endif
 }
 
+} // namespace cluon
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/Tracer.hpp"
+
+// clang-format off
+#ifdef WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+// clang-format on
+
+#include <fstream>
+#include <iomanip>
+
+namespace cluon {
+
+inline Tracer::Tracer() noexcept
+    : m_epoch(std::chrono::steady_clock::now()) {}
+
+inline void Tracer::enable(uint32_t eventsPerThread) noexcept {
+    m_eventsPerThread.store((0 < eventsPerThread) ? eventsPerThread : 1);
+    m_enabled.store(true);
+}
+
+inline void Tracer::disable() noexcept {
+    m_enabled.store(false);
+}
+
+inline const char *&Tracer::threadName() noexcept {
+    static thread_local const char *name{nullptr};
+    return name;
+}
+
+inline void Tracer::setThreadName(const char *name) noexcept {
+    // The name is picked up when the thread's buffer is created.
+    threadName() = name;
+}
+
+inline Tracer::ThreadBuffer *Tracer::threadBuffer() noexcept {
+    static thread_local ThreadBuffer *buffer{nullptr};
+    if (nullptr == buffer) {
+        try {
+            std::unique_ptr<ThreadBuffer> tb{new ThreadBuffer()};
+            tb->m_threadName = threadName();
+            tb->m_capacity   = m_eventsPerThread.load();
+            tb->m_events.reset(new Event[tb->m_capacity]);
+
+            std::lock_guard<std::mutex> lck(m_threadBuffersMutex);
+            tb->m_threadId = static_cast<uint32_t>(m_threadBuffers.size() + 1);
+            buffer         = tb.get();
+            m_threadBuffers.push_back(std::move(tb));
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+    return buffer;
+}
+
+inline void Tracer::record(const char *name,
+                           const char *category,
+                           std::chrono::steady_clock::time_point begin,
+                           std::chrono::steady_clock::time_point end) noexcept {
+    if (isEnabled()) {
+        ThreadBuffer *tb = threadBuffer();
+        if (nullptr != tb) {
+            // Only this thread appends to its buffer; readers never look beyond the published size.
+            const uint32_t SIZE{tb->m_size.load(std::memory_order_relaxed)};
+            if (SIZE < tb->m_capacity) {
+                Event &e     = tb->m_events[SIZE];
+                e.m_name     = name;
+                e.m_category = category;
+                e.m_begin    = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - m_epoch).count();
+                e.m_end      = std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_epoch).count();
+                tb->m_size.store(SIZE + 1, std::memory_order_release);
+            } else {
+                tb->m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+inline uint64_t Tracer::droppedEvents() const noexcept {
+    uint64_t dropped{0};
+    std::lock_guard<std::mutex> lck(m_threadBuffersMutex);
+    for (const auto &tb : m_threadBuffers) {
+        dropped += tb->m_dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+inline void Tracer::writeChromeTrace(std::ostream &out) const noexcept {
+#ifdef WIN32
+    const int PID{::_getpid()};
+#else
+    const int PID{::getpid()};
+#endif
+    try {
+        std::lock_guard<std::mutex> lck(m_threadBuffersMutex);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first{true};
+        for (const auto &tb : m_threadBuffers) {
+            if (nullptr != tb->m_threadName) {
+                out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PID << ",\"tid\":" << tb->m_threadId
+                    << ",\"args\":{\"name\":\"" << tb->m_threadName << "\"}}";
+                first = false;
+            }
+
+            const uint32_t SIZE{tb->m_size.load(std::memory_order_acquire)};
+            for (uint32_t i{0}; i < SIZE; i++) {
+                const Event &e = tb->m_events[i];
+                // Chrome trace time stamps are given in microseconds.
+                out << (first ? "" : ",") << "\n{\"name\":\"" << e.m_name << "\",\"cat\":\"" << e.m_category << "\",\"ph\":\"X\",\"pid\":" << PID
+                    << ",\"tid\":" << tb->m_threadId << ",\"ts\":" << e.m_begin / 1000 << '.' << std::setw(3) << std::setfill('0') << e.m_begin % 1000
+                    << std::setfill(' ') << ",\"dur\":" << (e.m_end - e.m_begin) / 1000 << '.' << std::setw(3) << std::setfill('0')
+                    << (e.m_end - e.m_begin) % 1000 << std::setfill(' ') << "}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline bool Tracer::writeChromeTrace(const std::string &fileName) const noexcept {
+    bool retVal{false};
+    try {
+        std::ofstream out(fileName, std::ios::out | std::ios::trunc);
+        if (out.good()) {
+            writeChromeTrace(out);
+            out.flush();
+            retVal = out.good();
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
 } // namespace cluon
 /*
  * Copyright (C) 2019  Christian Berger
@@ -10047,6 +12095,7 @@ inline std::string getIPv4FromHostname(const std::string &hostname) noexcept {
 #include <cerrno>
 #include <cstring>
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <sstream>
 #include <vector>
@@ -10125,31 +12174,154 @@ inline uint16_t UDPSender::getSendFromPort() const noexcept {
 }
 
 inline std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noexcept {
-    if (-1 == m_socket) {
+    return send(data.data(), data.size());
+}
+
+inline std::pair<ssize_t, int32_t> UDPSender::send(const char *data, std::size_t size) const noexcept {
+    if (-1 == m_socket) {
         return {-1, EBADF};
     }
 
-    if (data.empty()) {
+    if ((nullptr == data) || (0 == size)) {
         return {0, 0};
     }
 
     constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
                                     - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
                                     - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
-    if (MAX_LENGTH < data.size()) {
+    if (MAX_LENGTH < size) {
         return {-1, E2BIG};
     }
 
     std::lock_guard<std::mutex> lck(m_socketMutex);
     ssize_t bytesSent = ::sendto(m_socket,
-                                 data.c_str(),
-                                 data.length(),
+                                 data,
+                                 size,
                                  0,
                                  reinterpret_cast<const struct sockaddr *>(&m_sendToAddress), // NOLINT
                                  sizeof(m_sendToAddress));
+    m_numberOfSendCalls.fetch_add(1, std::memory_order_relaxed);
+    if (!(0 > bytesSent)) {
+        m_numberOfSentPackets.fetch_add(1, std::memory_order_relaxed);
+    }
 
     return {bytesSent, (0 > bytesSent ? errno : 0)};
 }
+
+inline std::pair<ssize_t, int32_t> UDPSender::queue(const char *data, std::size_t size) noexcept {
+    if (-1 == m_socket) {
+        return {-1, EBADF};
+    }
+
+    if ((nullptr == data) || (0 == size)) {
+        return {0, 0};
+    }
+
+    constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    if (MAX_LENGTH < size) {
+        return {-1, E2BIG};
+    }
+
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+    try {
+        m_queuedPackets.emplace_back(m_queuedData.size(), size);
+        m_queuedData.append(data, size);
+    } catch (...) {
+        return {-1, ENOMEM}; // LCOV_EXCL_LINE
+    }
+    if (SEND_BATCH_SIZE <= m_queuedPackets.size()) {
+        std::pair<ssize_t, int32_t> retVal{flushQueue()};
+        if (0 != retVal.second) {
+            return retVal;
+        }
+    }
+    return {static_cast<ssize_t>(size), 0};
+}
+
+inline std::pair<ssize_t, int32_t> UDPSender::flush() noexcept {
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+    return flushQueue();
+}
+
+inline std::pair<ssize_t, int32_t> UDPSender::flushQueue() noexcept {
+    ssize_t totalBytesSent{0};
+    int32_t firstError{0};
+#ifdef __linux__
+    std::array<struct mmsghdr, SEND_BATCH_SIZE> messages{};
+    std::array<struct iovec, SEND_BATCH_SIZE> ioVectors{};
+
+    std::size_t next{0};
+    while (next < m_queuedPackets.size()) {
+        const std::size_t count{std::min(static_cast<std::size_t>(SEND_BATCH_SIZE), m_queuedPackets.size() - next)};
+        for (std::size_t i{0}; i < count; i++) {
+            ioVectors[i].iov_base           = &m_queuedData[m_queuedPackets[next + i].first];
+            ioVectors[i].iov_len            = m_queuedPackets[next + i].second;
+            messages[i].msg_hdr.msg_name    = &m_sendToAddress;
+            messages[i].msg_hdr.msg_namelen = sizeof(m_sendToAddress);
+            messages[i].msg_hdr.msg_iov     = &ioVectors[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+            messages[i].msg_len             = 0;
+        }
+
+        const int sent{::sendmmsg(m_socket, messages.data(), static_cast<unsigned int>(count), 0)};
+        m_numberOfSendCalls.fetch_add(1, std::memory_order_relaxed);
+        if (0 > sent) {
+            // The first packet failed; skip it and continue with the rest.
+            firstError = (0 == firstError) ? errno : firstError;
+            next++;
+        } else {
+            for (int i{0}; i < sent; i++) {
+                totalBytesSent += static_cast<ssize_t>(messages[static_cast<std::size_t>(i)].msg_len);
+            }
+            m_numberOfSentPackets.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+            // A partial batch is continued with the first packet not sent.
+            next += static_cast<std::size_t>(sent);
+        }
+    }
+#else
+    for (const auto &packet : m_queuedPackets) {
+        ssize_t bytesSent = ::sendto(m_socket,
+                                     &m_queuedData[packet.first],
+                                     packet.second,
+                                     0,
+                                     reinterpret_cast<const struct sockaddr *>(&m_sendToAddress), // NOLINT
+                                     sizeof(m_sendToAddress));
+        m_numberOfSendCalls.fetch_add(1, std::memory_order_relaxed);
+        if (0 > bytesSent) {
+            firstError = (0 == firstError) ? errno : firstError;
+        } else {
+            totalBytesSent += bytesSent;
+            m_numberOfSentPackets.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+#endif
+    // The capacities are kept for the next batch.
+    m_queuedData.clear();
+    m_queuedPackets.clear();
+    return {totalBytesSent, firstError};
+}
+
+inline uint64_t UDPSender::numberOfSentPackets() const noexcept {
+    return m_numberOfSentPackets.load(std::memory_order_relaxed);
+}
+
+inline uint64_t UDPSender::numberOfSendCalls() const noexcept {
+    return m_numberOfSendCalls.load(std::memory_order_relaxed);
+}
+
+inline bool UDPSender::multicastLoopback(bool enable) noexcept {
+    if (-1 == m_socket) {
+        return false;
+    }
+#ifdef WIN32
+    const DWORD LOOPBACK{enable ? 1u : 0u};
+#else
+    const unsigned char LOOPBACK{static_cast<unsigned char>(enable ? 1 : 0)};
+#endif
+    return (0 == ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<const char *>(&LOOPBACK), sizeof(LOOPBACK))); // NOLINT
+}
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -10177,11 +12349,14 @@ inline std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noe
 #else
     #ifdef __linux__
         #include <linux/sockios.h>
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
     #endif
 
     #include <arpa/inet.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/stat.h>
     #include <sys/types.h>
     #include <fcntl.h>
     #include <unistd.h>
@@ -10204,11 +12379,68 @@ inline std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noe
 
 namespace cluon {
 
+inline UDPDatagram::UDPDatagram(const char *data, size_t size, const struct sockaddr_in &sender, std::chrono::system_clock::time_point sampleTime) noexcept
+    : m_data(data)
+    , m_size(size)
+    , m_sender(sender)
+    , m_sampleTime(sampleTime) {}
+
+inline const char *UDPDatagram::data() const noexcept {
+    return m_data;
+}
+
+inline size_t UDPDatagram::size() const noexcept {
+    return m_size;
+}
+
+inline std::string UDPDatagram::dataAsString() const noexcept {
+    std::string retVal;
+    try {
+        retVal.assign(m_data, m_size);
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline const struct sockaddr_in &UDPDatagram::sender() const noexcept {
+    return m_sender;
+}
+
+inline std::string UDPDatagram::senderAsString() const noexcept {
+    std::string retVal;
+    try {
+        // Transform sender address to C-string.
+        std::array<char, INET_ADDRSTRLEN> address{};
+        ::inet_ntop(AF_INET, &(m_sender.sin_addr), address.data(), address.max_size());
+        retVal = std::string(address.data()) + ':' + std::to_string(ntohs(m_sender.sin_port));
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline std::chrono::system_clock::time_point UDPDatagram::sampleTime() const noexcept {
+    return m_sampleTime;
+}
+
 inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
-                         uint16_t receiveFromPort,
-                         std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
-                         uint16_t localSendFromPort) noexcept
+                                uint16_t receiveFromPort,
+                                std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
+                                uint16_t localSendFromPort) noexcept
+    : UDPReceiver(receiveFromAddress,
+                  receiveFromPort,
+                  (nullptr == delegate) ? std::function<void(const UDPDatagram &)>()
+                                        : std::function<void(const UDPDatagram &)>([delegate](const UDPDatagram &datagram) {
+                                              delegate(datagram.dataAsString(), datagram.senderAsString(), datagram.sampleTime());
+                                          }),
+                  localSendFromPort) {}
+
+inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
+                                uint16_t receiveFromPort,
+                                std::function<void(const UDPDatagram &)> delegate,
+                                uint16_t localSendFromPort,
+                                size_t queueCapacity,
+                                OverflowPolicy overflowPolicy) noexcept
     : m_localSendFromPort(localSendFromPort)
+    , m_queueCapacity(queueCapacity)
+    , m_overflowPolicy(overflowPolicy)
     , m_receiveFromAddress()
     , m_mreq()
     , m_readFromSocketThread()
@@ -10314,6 +12546,17 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
             }
         }
 
+#ifdef __linux__
+        if (!(m_socket < 0)) {
+            // Let the kernel attach a receive time stamp to every datagram.
+            int enable{1};
+            auto retVal = ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, reinterpret_cast<char *>(&enable), sizeof(enable));
+            if (retVal < 0) {
+                std::cerr << "[cluon::UDPReceiver] Error while trying to set SO_TIMESTAMPNS: " << errno << std::endl; // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
         if (!(m_socket < 0)) {
             // Bind to receive address/port.
             // clang-format off
@@ -10387,6 +12630,26 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
 #endif
         }
 
+#ifdef __linux__
+        if (!(m_socket < 0)) {
+            // Wait for data or the stop signal without polling.
+            m_epoll  = ::epoll_create1(EPOLL_CLOEXEC);
+            m_wakeUp = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            struct epoll_event socketEvent {};
+            socketEvent.events  = EPOLLIN;
+            socketEvent.data.fd = m_socket;
+            struct epoll_event wakeUpEvent {};
+            wakeUpEvent.events  = EPOLLIN;
+            wakeUpEvent.data.fd = m_wakeUp;
+
+            if ((m_epoll < 0) || (m_wakeUp < 0) || (0 != ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_socket, &socketEvent))
+                || (0 != ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeUp, &wakeUpEvent))) {
+                closeSocket(errno); // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
         if (!(m_socket < 0)) {
             // Constructing the receiving thread could fail.
             try {
@@ -10399,7 +12662,16 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
 
             try {
                 m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(
-                    [this](PipelineEntry &&entry) { this->m_delegate(std::move(entry.m_data), std::move(entry.m_from), std::move(entry.m_sampleTime)); });
+                    [this](PipelineEntry &&entry) {
+                        {
+                            TraceSpan span("UDPReceiver::dispatch", "cluon");
+                            this->m_delegate(UDPDatagram(entry.m_data.data(), entry.m_data.size(), entry.m_from, entry.m_sampleTime));
+                        }
+                        this->releaseBuffer(std::move(entry.m_data));
+                    },
+                    m_queueCapacity,
+                    m_overflowPolicy,
+                    [this](PipelineEntry &&entry) { this->releaseBuffer(std::move(entry.m_data)); });
                 if (m_pipeline) {
                     // Let the operating system spawn the thread.
                     using namespace std::literals::chrono_literals; // NOLINT
@@ -10414,6 +12686,16 @@ inline UDPReceiver::~UDPReceiver() noexcept {
     {
         m_readFromSocketThreadRunning.store(false);
 
+#ifdef __linux__
+        // Wake up the receiving thread immediately.
+        if (!(m_wakeUp < 0)) {
+            const uint64_t ONE{1};
+            if (0 > ::write(m_wakeUp, &ONE, sizeof(ONE))) {
+                std::cerr << "[cluon::UDPReceiver] Failed to wake up receiving thread: " << errno << std::endl; // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
         // Joining the thread could fail.
         try {
             if (m_readFromSocketThread.joinable()) {
@@ -10457,35 +12739,147 @@ inline void UDPReceiver::closeSocket(int errorCode) noexcept {
 #endif
     }
     m_socket = -1;
+
+#ifdef __linux__
+    if (!(m_epoll < 0)) {
+        ::close(m_epoll);
+    }
+    m_epoll = -1;
+    if (!(m_wakeUp < 0)) {
+        ::close(m_wakeUp);
+    }
+    m_wakeUp = -1;
+#endif
 }
 
 inline bool UDPReceiver::isRunning() const noexcept {
     return (m_readFromSocketThreadRunning.load() && !TerminateHandler::instance().isTerminated.load());
 }
 
+inline uint64_t UDPReceiver::numberOfReceivedPackets() const noexcept {
+    return m_numberOfReceivedPackets.load(std::memory_order_relaxed);
+}
+
+inline uint64_t UDPReceiver::numberOfReceiveCalls() const noexcept {
+    return m_numberOfReceiveCalls.load(std::memory_order_relaxed);
+}
+
+inline uint64_t UDPReceiver::numberOfDroppedPackets() const noexcept {
+    return (m_pipeline ? m_pipeline->numberOfDroppedEntries() : 0);
+}
+
+inline size_t UDPReceiver::queueHighWaterMark() const noexcept {
+    return (m_pipeline ? m_pipeline->highWaterMark() : 0);
+}
+
+inline uint64_t UDPReceiver::socketInode() const noexcept {
+    uint64_t retVal{0};
+#ifndef WIN32
+    struct stat socketStatus {};
+    if (!(m_socket < 0) && (0 == ::fstat(m_socket, &socketStatus))) {
+        retVal = static_cast<uint64_t>(socketStatus.st_ino);
+    }
+#endif
+    return retVal;
+}
+
+inline std::vector<char> UDPReceiver::acquireBuffer() noexcept {
+    std::vector<char> buffer;
+    try {
+        std::lock_guard<std::mutex> lck(m_bufferPoolMutex);
+        if (!m_bufferPool.empty()) {
+            buffer = std::move(m_bufferPool.back());
+            m_bufferPool.pop_back();
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return buffer;
+}
+
+inline void UDPReceiver::releaseBuffer(std::vector<char> &&buffer) noexcept {
+    try {
+        std::lock_guard<std::mutex> lck(m_bufferPoolMutex);
+        if (m_bufferPool.size() < MAX_POOLED_BUFFERS) {
+            buffer.clear();
+            m_bufferPool.push_back(std::move(buffer));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline bool UDPReceiver::processDatagram(const char *data,
+                                         size_t length,
+                                         const struct sockaddr_storage &remote,
+                                         std::chrono::system_clock::time_point timestamp) noexcept {
+    const struct sockaddr_in &REMOTE{*reinterpret_cast<const struct sockaddr_in *>(&remote)}; // NOLINT
+    const unsigned long RECVFROM_IP{REMOTE.sin_addr.s_addr};
+    const uint16_t RECVFROM_PORT{ntohs(REMOTE.sin_port)};
+
+    // Check if the bytes actually came from us.
+    bool sentFromUs{false};
+    {
+        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
+        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
+        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
+    }
+
+    // Create a pipeline entry to be processed concurrently.
+    if (!sentFromUs) {
+        try {
+            PipelineEntry pe;
+            // A recycled buffer only allocates if it has never held a datagram this large.
+            pe.m_data = acquireBuffer();
+            pe.m_data.assign(data, data + length);
+            pe.m_from       = REMOTE;
+            pe.m_sampleTime = timestamp;
+
+            // Store entry in queue.
+            if (m_pipeline) {
+                m_pipeline->add(std::move(pe));
+            }
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+    return !sentFromUs;
+}
+
 inline void UDPReceiver::readFromSocket() noexcept {
     // Create buffer to store data from socket.
     constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
                                     - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
                                     - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+#ifdef __linux__
+    // Buffers, sender addresses, and time stamps for a burst of datagrams received with one recvmmsg call.
+    std::vector<char> buffer(static_cast<size_t>(RECEIVE_BATCH_SIZE) * MAX_LENGTH);
+    std::array<struct mmsghdr, RECEIVE_BATCH_SIZE> messages{};
+    std::array<struct iovec, RECEIVE_BATCH_SIZE> ioVectors{};
+    std::array<struct sockaddr_storage, RECEIVE_BATCH_SIZE> remotes{};
+    std::array<std::array<char, CMSG_SPACE(sizeof(struct timespec))>, RECEIVE_BATCH_SIZE> controls{};
+
+    std::array<struct epoll_event, 2> events{};
+#else
     std::array<char, MAX_LENGTH> buffer{};
 
+    struct sockaddr_storage remote {};
+    socklen_t addrLength{sizeof(remote)};
+
     struct timeval timeout {};
 
     // Define file descriptor set to watch for read operations.
     fd_set setOfFiledescriptorsToReadFrom{};
+#endif
 
-    // Sender address and port.
-    constexpr uint16_t MAX_ADDR_SIZE{1024};
-    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
-
-    struct sockaddr_storage remote {};
-    socklen_t addrLength{sizeof(remote)};
+    Tracer::instance().setThreadName("cluon::UDPReceiver");
 
     // Indicate to main thread that we are ready.
     m_readFromSocketThreadRunning.store(true);
 
     while (m_readFromSocketThreadRunning.load()) {
+        bool isReadable{false};
+#ifdef __linux__
+        // Block until data is available or the destructor signals the eventfd.
+        const int numberOfEvents{::epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), -1)};
+        for (int i{0}; i < numberOfEvents; i++) {
+            isReadable |= (m_socket == events[static_cast<size_t>(i)].data.fd);
+        }
+#else
         // Define timeout for select system call. The timeval struct must be
         // reinitialized for every select call as it might be modified containing
         // the actual time slept.
@@ -10495,66 +12889,76 @@ inline void UDPReceiver::readFromSocket() noexcept {
         FD_ZERO(&setOfFiledescriptorsToReadFrom);          // NOLINT
         FD_SET(m_socket, &setOfFiledescriptorsToReadFrom); // NOLINT
         ::select(m_socket + 1, &setOfFiledescriptorsToReadFrom, nullptr, nullptr, &timeout);
+        isReadable = FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom); // NOLINT
+#endif
 
         ssize_t totalBytesRead{0};
-        if (FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom)) { // NOLINT
+        if (isReadable && m_readFromSocketThreadRunning.load()) {
+#ifdef __linux__
+            int received{0};
+            do {
+                TraceSpan span("UDPReceiver::receive", "cluon");
+                // The headers must be reset for every call as the kernel modifies the lengths.
+                for (uint32_t i{0}; i < RECEIVE_BATCH_SIZE; i++) {
+                    ioVectors[i].iov_base                  = &buffer[static_cast<size_t>(i) * MAX_LENGTH];
+                    ioVectors[i].iov_len                   = MAX_LENGTH;
+                    messages[i].msg_hdr.msg_name           = &remotes[i];
+                    messages[i].msg_hdr.msg_namelen        = sizeof(remotes[i]);
+                    messages[i].msg_hdr.msg_iov            = &ioVectors[i];
+                    messages[i].msg_hdr.msg_iovlen         = 1;
+                    messages[i].msg_hdr.msg_control        = controls[i].data();
+                    messages[i].msg_hdr.msg_controllen     = controls[i].size();
+                    messages[i].msg_hdr.msg_flags          = 0;
+                    messages[i].msg_len                    = 0;
+                }
+
+                // Pull in everything that is pending up to a full batch without blocking.
+                received = ::recvmmsg(m_socket, messages.data(), RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+                m_numberOfReceiveCalls.fetch_add(1, std::memory_order_relaxed);
+
+                for (int i{0}; (i < received) && (nullptr != m_delegate); i++) {
+                    m_numberOfReceivedPackets.fetch_add(1, std::memory_order_relaxed);
+                    if (0 == messages[i].msg_len) {
+                        continue;
+                    }
+
+                    // Find the kernel's time stamp in the control data; fall back to chrono.
+                    std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+                    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); nullptr != cmsg; cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg)) {
+                        if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPNS == cmsg->cmsg_type)) {
+                            struct timespec receivedTimeStamp {};
+                            std::memcpy(&receivedTimeStamp, CMSG_DATA(cmsg), sizeof(receivedTimeStamp)); // NOLINT
+                            // Transform struct timespec to C++ chrono.
+                            std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> transformedTimePoint(
+                                std::chrono::nanoseconds(receivedTimeStamp.tv_sec * 1000000000L + receivedTimeStamp.tv_nsec));
+                            timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
+                        }
+                    }
+
+                    processDatagram(&buffer[static_cast<size_t>(i) * MAX_LENGTH], messages[i].msg_len, remotes[i], timestamp);
+                    totalBytesRead += static_cast<ssize_t>(messages[i].msg_len);
+                }
+                // A partial batch means that the socket's queue has been drained.
+            } while (static_cast<int>(RECEIVE_BATCH_SIZE) == received);
+#else
             ssize_t bytesRead{0};
             do {
+                TraceSpan span("UDPReceiver::receive", "cluon");
                 bytesRead = ::recvfrom(m_socket,
                                        buffer.data(),
                                        buffer.max_size(),
                                        0,
                                        reinterpret_cast<struct sockaddr *>(&remote), // NOLINT
                                        reinterpret_cast<socklen_t *>(&addrLength));  // NOLINT
+                m_numberOfReceiveCalls.fetch_add(1, std::memory_order_relaxed);
 
                 if ((0 < bytesRead) && (nullptr != m_delegate)) {
-#ifdef __linux__
-                    std::chrono::system_clock::time_point timestamp;
-                    struct timeval receivedTimeStamp {};
-                    if (0 == ::ioctl(m_socket, SIOCGSTAMP, &receivedTimeStamp)) { // NOLINT
-                        // Transform struct timeval to C++ chrono.
-                        std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> transformedTimePoint(
-                            std::chrono::microseconds(receivedTimeStamp.tv_sec * 1000000L + receivedTimeStamp.tv_usec));
-                        timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
-                    } else { // LCOV_EXCL_LINE
-                        // In case the ioctl failed, fall back to chrono. // LCOV_EXCL_LINE
-                        timestamp = std::chrono::system_clock::now(); // LCOV_EXCL_LINE
-                    }
-#else
-                    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
-#endif
-
-                    // Transform sender address to C-string.
-                    ::inet_ntop(remote.ss_family,
-                                &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
-                                remoteAddress.data(),
-                                remoteAddress.max_size());
-                    const unsigned long RECVFROM_IP{reinterpret_cast<struct sockaddr_in *>(&remote)->sin_addr.s_addr}; // NOLINT
-                    const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)};    // NOLINT
-
-                    // Check if the bytes actually came from us.
-                    bool sentFromUs{false};
-                    {
-                        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
-                        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
-                        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
-                    }
-
-                    // Create a pipeline entry to be processed concurrently.
-                    if (!sentFromUs) {
-                        PipelineEntry pe;
-                        pe.m_data       = std::string(buffer.data(), static_cast<size_t>(bytesRead));
-                        pe.m_from       = std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT);
-                        pe.m_sampleTime = timestamp;
-
-                        // Store entry in queue.
-                        if (m_pipeline) {
-                            m_pipeline->add(std::move(pe));
-                        }
-                    }
+                    m_numberOfReceivedPackets.fetch_add(1, std::memory_order_relaxed);
+                    processDatagram(buffer.data(), static_cast<size_t>(bytesRead), remote, std::chrono::system_clock::now());
                     totalBytesRead += bytesRead;
                 }
             } while (!m_isBlockingSocket && (bytesRead > 0));
+#endif
         }
 
         if (static_cast<int32_t>(totalBytesRead) > 0) {
@@ -11048,15 +13452,26 @@ inline void TCPServer::readFromSocket() noexcept {
 
 //#include "cluon/ToProtoVisitor.hpp"
 
+#include <array>
 #include <cstring>
 
 namespace cluon {
 
+inline ToProtoVisitor::ToProtoVisitor(std::string &buffer) noexcept
+    : m_out{&buffer} {}
+
+inline ToProtoVisitor::ToProtoVisitor(std::string *out) noexcept
+    : m_out{out} {}
+
 inline std::string ToProtoVisitor::encodedData() const noexcept {
-    std::string s{m_buffer.str()};
+    std::string s{(nullptr != m_out) ? *m_out : std::string()};
     return s;
 }
 
+inline std::size_t ToProtoVisitor::encodedSize() const noexcept {
+    return m_size;
+}
+
 inline void ToProtoVisitor::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
     (void)id;
     (void)shortName;
@@ -11130,94 +13545,112 @@ inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::stri
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::FOUR_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
 }
 
 inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
 }
 
 inline void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(key);
+    encode(v);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, bool &v) noexcept {
+inline void ToProtoVisitor::visit(uint32_t &id, std::string &&typeName, std::string &&name, cluon::data::TimeStamp &v) noexcept {
+    (void)typeName;
+    (void)name;
+
+    // Every Envelope carries three TimeStamps; their two fields are encoded
+    // directly instead of visiting them to skip building their names.
+    int32_t seconds{v.seconds()};
+    int32_t microseconds{v.microseconds()};
+    cluon::ToProtoVisitor sizeCalculator{static_cast<std::string *>(nullptr)};
+    sizeCalculator.toKeyValue<int32_t>(1, seconds);
+    sizeCalculator.toKeyValue<int32_t>(2, microseconds);
+
+    toVarInt(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED)));
+    toVarInt(sizeCalculator.m_size);
+    toKeyValue<int32_t>(1, seconds);
+    toKeyValue<int32_t>(2, microseconds);
+}
+
+inline std::size_t ToProtoVisitor::encode(bool &v) noexcept {
     uint64_t _v{(v ? 1u : 0u)};
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int8_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int8_t &v) noexcept {
     uint64_t _v = toZigZag8(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint8_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint8_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int16_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int16_t &v) noexcept {
     uint64_t _v = toZigZag16(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint16_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint16_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int32_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int32_t &v) noexcept {
     uint64_t _v = toZigZag32(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint32_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(uint32_t &v) noexcept {
     uint64_t _v = v;
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, int64_t &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(int64_t &v) noexcept {
     uint64_t _v = toZigZag64(v);
-    return toVarInt(o, _v);
+    return toVarInt(_v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, uint64_t &v) noexcept {
-    return toVarInt(o, v);
+inline std::size_t ToProtoVisitor::encode(uint64_t &v) noexcept {
+    return toVarInt(v);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, float &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(float &v) noexcept {
     // Store 4 bytes as little endian encoding.
     uint32_t _v{0};
     std::memmove(&_v, &v, sizeof(float));
     _v = htole32(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
+    write(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
     return sizeof(uint32_t);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, double &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(double &v) noexcept {
     // Store 8 bytes as little endian encoding.
     uint64_t _v{0};
     std::memmove(&_v, &v, sizeof(double));
     _v = htole64(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
+    write(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
     return sizeof(uint64_t);
 }
 
-inline std::size_t ToProtoVisitor::encode(std::ostream &o, const std::string &v) noexcept {
+inline std::size_t ToProtoVisitor::encode(const std::string &v) noexcept {
     const std::size_t LENGTH = v.length();
-    std::size_t size         = toVarInt(o, LENGTH);
-    o.write(v.c_str(), static_cast<std::streamsize>(LENGTH)); // LENGTH won't be negative.
+    std::size_t size         = toVarInt(LENGTH);
+    write(v.data(), LENGTH);
     return size + LENGTH;
 }
 
@@ -11241,23 +13674,33 @@ inline uint64_t ToProtoVisitor::encodeKey(uint32_t fieldIdentifier, uint8_t prot
     return (fieldIdentifier << 0x3) | protoType;
 }
 
-inline std::size_t ToProtoVisitor::toVarInt(std::ostream &out, uint64_t v) noexcept {
+inline std::size_t ToProtoVisitor::toVarInt(uint64_t v) noexcept {
+    // A uint64_t takes at most 10 bytes.
+    std::array<char, 10> bytes;
     // Minimum size is of the encoded data.
     std::size_t size{1};
     uint8_t b{0};
     while (0x7f < v) {
         // Use the MSB to indicate value overflow for more bytes to come.
         b = (static_cast<uint8_t>(v & 0x7f)) | 0x80;
-        out.put(static_cast<char>(b));
+        bytes[size - 1] = static_cast<char>(b);
         v >>= 7;
         size++;
     }
     // Write final byte.
     b = (static_cast<uint8_t>(v)) & 0x7f;
-    out.put(static_cast<char>(b));
+    bytes[size - 1] = static_cast<char>(b);
+    write(bytes.data(), size);
 
     return size;
 }
+
+inline void ToProtoVisitor::write(const char *data, std::size_t size) noexcept {
+    if (nullptr != m_out) {
+        m_out->append(data, size);
+    }
+    m_size += size;
+}
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -11340,6 +13783,73 @@ inline void FromProtoVisitor::decodeFrom(std::istream &in) noexcept {
     }
 }
 
+inline void FromProtoVisitor::decodeFrom(const char *data, std::size_t size) noexcept {
+    // Reset internal states as this deserializer could be reused.
+    m_mapOfKeyValues.clear();
+    if (nullptr == data) {
+        return;
+    }
+    const char *pos{data};
+    const char *end{data + size};
+    while (pos < end) {
+        // First stage: Read keyFieldType (encoded as VarInt).
+        if (0 == fromVarInt(pos, end, m_keyFieldType)) {
+            break;
+        }
+        m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
+        m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
+        switch (m_protoType) {
+            case ProtoConstants::VARINT:
+            {
+                fromVarInt(pos, end, m_value);
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_value));
+            }
+            break;
+            case ProtoConstants::EIGHT_BYTES:
+            {
+                if (static_cast<std::size_t>(end - pos) < sizeof(double)) {
+                    pos = end;
+                    break;
+                }
+                std::memcpy(m_doubleValue.buffer.data(), pos, sizeof(double));
+                pos += sizeof(double);
+                m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_doubleValue.doubleValue));
+            }
+            break;
+            case ProtoConstants::FOUR_BYTES:
+            {
+                if (static_cast<std::size_t>(end - pos) < sizeof(float)) {
+                    pos = end;
+                    break;
+                }
+                std::memcpy(m_floatValue.buffer.data(), pos, sizeof(float));
+                pos += sizeof(float);
+                m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_floatValue.floatValue));
+            }
+            break;
+            case ProtoConstants::LENGTH_DELIMITED:
+            {
+                fromVarInt(pos, end, m_value);
+                if (static_cast<uint64_t>(end - pos) < m_value) {
+                    pos = end;
+                    break;
+                }
+                m_mapOfKeyValues.emplace(m_fieldId, linb::any(std::string(pos, static_cast<std::size_t>(m_value))));
+                pos += m_value;
+            }
+            break;
+            default:
+            {
+                // Unknown wire type; the remaining bytes cannot be interpreted.
+                pos = end;
+            }
+            break;
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 inline FromProtoVisitor &FromProtoVisitor::operator=(const FromProtoVisitor &other) noexcept {
@@ -11537,7 +14047,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = std::string(m_stringValue.data(), static_cast<std::size_t>(m_value));
+        v.assign(m_bytes, static_cast<std::size_t>(m_value));
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11549,6 +14059,30 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
 
 ////////////////////////////////////////////////////////////////////////////////
 
+inline void FromProtoVisitor::acceptField(cluon::data::Envelope &v) noexcept {
+    // Envelope::accept would build the type name of its TimeStamps on the
+    // heap for every field; they are decoded straight into the Envelope.
+    if ((ProtoConstants::LENGTH_DELIMITED == m_protoType) && (3 <= m_fieldId) && (5 >= m_fieldId)) {
+        cluon::data::TimeStamp timeStamp;
+        cluon::FromProtoVisitor nestedProtoDecoder;
+        nestedProtoDecoder.decodeFrom(m_bytes, static_cast<std::size_t>(m_value), timeStamp);
+        if (3 == m_fieldId) {
+            v.sent(timeStamp);
+        }
+        else if (4 == m_fieldId) {
+            v.received(timeStamp);
+        }
+        else {
+            v.sampleTimeStamp(timeStamp);
+        }
+    }
+    else {
+        v.accept(m_fieldId, *this);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 inline int8_t FromProtoVisitor::fromZigZag8(uint8_t v) noexcept {
     return static_cast<int8_t>((v >> 1) ^ -(v & 1));
 }
@@ -11585,13 +14119,33 @@ inline std::size_t FromProtoVisitor::fromVarInt(std::istream &in, uint64_t &valu
 
     return size;
 }
-} // namespace cluon
-/*
- * Copyright (C) 2017-2018  Christian Berger
- *
- * This Source Code Form is subject to the terms of the Mozilla Public
- * License, v. 2.0. If a copy of the MPL was not distributed with this
- * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+inline std::size_t FromProtoVisitor::fromVarInt(const char *&pos, const char *end, uint64_t &value) noexcept {
+    value = 0;
+
+    constexpr uint64_t MASK  = 0x7f;
+    constexpr uint64_t SHIFT = 0x7;
+    constexpr uint64_t MSB   = 0x80;
+
+    std::size_t size = 0;
+    uint64_t C{0};
+    while ((pos < end) && (size < 10)) {
+        C = static_cast<uint64_t>(static_cast<uint8_t>(*pos++));
+        value |= (C & MASK) << (SHIFT * size++);
+        if (!(C & MSB)) { // NOLINT
+            break;
+        }
+    }
+
+    return size;
+}
+} // namespace cluon
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
 // clang-format off
@@ -13919,6 +16473,723 @@ inline void ToMsgPackVisitor::visit(uint32_t id, std::string &&typeName, std::st
     m_numberOfFields++;
 }
 
+} // namespace cluon
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//#include "cluon/LocalTransport.hpp"
+//#include "cluon/Tracer.hpp"
+//#include "cluon/UDPPacketSizeConstraints.hpp"
+
+// clang-format off
+#ifdef __linux__
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <ifaddrs.h>
+    #include <linux/futex.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+
+namespace cluon {
+
+#ifdef __linux__
+// Layout of the shared memory: this header followed by the ring of datagrams.
+struct LocalTransport::Header {
+    static constexpr uint32_t MAGIC{0x0D4A0004};
+    static constexpr uint64_t CAPACITY{4 * 1024 * 1024};
+    static constexpr std::size_t NUMBER_OF_PEERS{64};
+    // Marks the unused rest of the ring; the next datagram starts at the ring's beginning.
+    static constexpr uint32_t WRAP_AROUND{0xFFFFFFFF};
+    // While sending, the receivers on this host are looked up at most this often.
+    static constexpr int64_t CHECK_PERIOD_IN_NANOSECONDS{1000 * 1000 * 1000};
+    // A writer waits at most this long for a reader that lags behind by the ring's capacity.
+    static constexpr int64_t BACKPRESSURE_TIMEOUT_IN_NANOSECONDS{100 * 1000 * 1000};
+
+    // Datagrams are stored 8-byte aligned behind their length and the sender's UDP port.
+    struct Record {
+        uint32_t m_length;
+        uint32_t m_sendFromPort;
+    };
+
+    // Attached OD4Session. Its reading thread locks the robust mutex m_alive when it claims the slot and
+    // holds it until it releases the slot; when the process dies, the next one to lock m_alive gets
+    // EOWNERDEAD. Slots are only claimed while holding m_writerMutex and m_alive.
+    struct Peer {
+        pthread_mutex_t m_alive;
+        std::atomic<uint64_t> m_owner;
+        std::atomic<uint32_t> m_sendFromPort;
+        std::atomic<uint64_t> m_socketInode;
+        // Bytes read by the owner; writers wait for it before overwriting datagrams it has not read.
+        std::atomic<uint64_t> m_readPosition;
+    };
+
+    // Written last by the creator of the shared memory.
+    std::atomic<uint32_t> m_magic;
+    uint32_t m_capacity;
+    // Serializes the writers of all processes; robust against writers that die while writing.
+    pthread_mutex_t m_writerMutex;
+    // Bytes claimed by the current writer and bytes completely written since the ring was created;
+    // a reader detects that a datagram was overwritten while being copied by the claimed bytes.
+    std::atomic<uint64_t> m_reserved;
+    std::atomic<uint64_t> m_committed;
+    // Futex word that is incremented after every datagram, and the number of sleeping readers.
+    std::atomic<uint32_t> m_futex;
+    std::atomic<uint32_t> m_waiters;
+    // Futex word that readers increment when they have read on while writers wait for them, and the number of those writers.
+    std::atomic<uint32_t> m_progress;
+    std::atomic<uint32_t> m_writersWaiting;
+    Peer m_peers[NUMBER_OF_PEERS];
+};
+#else
+struct LocalTransport::Header {};
+#endif
+
+inline LocalTransport::LocalTransport(uint16_t CID,
+                                      uint16_t sendFromPort,
+                                      std::function<void(const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point)> delegate) noexcept
+    : m_sendFromPort{sendFromPort}
+    , m_delegate{std::move(delegate)} {
+#ifdef __linux__
+    const char *SHM{::getenv("CLUON_OD4_SHM")};
+    if (((nullptr != SHM) && (0 == std::strcmp(SHM, "0"))) || (0 == m_sendFromPort) || (nullptr == m_delegate)) {
+        return;
+    }
+
+    // Sockets receiving the multicast group are listed in /proc/net/udp with the group's address in network byte order.
+    {
+        struct in_addr group {};
+        ::inet_pton(AF_INET, ("225.0.0." + std::to_string(CID)).c_str(), &group);
+        std::array<char, 16> address{};
+        std::snprintf(address.data(), address.size(), "%08X:%04X", group.s_addr, 12175);
+        m_groupAddressInProcNetUDP = address.data();
+    }
+
+    // Datagrams from these addresses may come from attached OD4Sessions.
+    struct ifaddrs *interfaceAddress;
+    if (0 == ::getifaddrs(&interfaceAddress)) {
+        for (struct ifaddrs *it = interfaceAddress; nullptr != it; it = it->ifa_next) {
+            if ((nullptr != it->ifa_addr) && (it->ifa_addr->sa_family == AF_INET)) {
+                struct sockaddr_in tmpSocketAddress {};
+                std::memcpy(&tmpSocketAddress, it->ifa_addr, sizeof(tmpSocketAddress)); /* Flawfinder: ignore */ // NOLINT
+                m_listOfLocalIPAddresses.insert(tmpSocketAddress.sin_addr.s_addr);
+            }
+        }
+        ::freeifaddrs(interfaceAddress);
+    }
+
+    // The owner token distinguishes this OD4Session from earlier ones that held the same slot.
+    {
+        static std::atomic<uint32_t> numberOfInstances{0};
+        const uint64_t START{static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())};
+        m_owner = (static_cast<uint64_t>(::getpid()) << 32) | static_cast<uint32_t>(START + numberOfInstances.fetch_add(1));
+        m_owner = (0 == m_owner) ? 1 : m_owner;
+    }
+
+    m_name = "/cluon-od4-" + std::to_string(CID);
+    bool retry{true};
+    for (uint32_t attempt{0}; !isRunning() && retry && (attempt < 3); attempt++) {
+        if (mapSharedMemory(retry)) {
+            // The reading thread claims the slot as it holds the slot's m_alive for as long as it is attached.
+            m_claim.store(Claim::PENDING);
+            m_readFromRingThreadRunning.store(true);
+            try {
+                if (!m_pipeline) {
+                    m_laggingReaders.assign(Header::NUMBER_OF_PEERS, UINT64_MAX);
+                    m_pipeline = std::make_unique<NotifyingPipeline<PipelineEntry>>([this](PipelineEntry &&entry) {
+                        this->m_delegate(entry.m_data.data(), entry.m_data.size(), entry.m_sendFromPort, entry.m_sampleTime);
+                        this->releaseBuffer(std::move(entry.m_data));
+                    });
+                }
+                m_readFromRingThread = std::thread(&LocalTransport::readFromRing, this);
+
+                // Let the operating system spawn the thread.
+                using namespace std::literals::chrono_literals; // NOLINT
+                do { std::this_thread::sleep_for(1ms); } while (Claim::PENDING == m_claim.load());
+            } catch (...) { m_claim.store(Claim::FAILED); } // LCOV_EXCL_LINE
+
+            if (Claim::CLAIMED != m_claim.load()) {
+                m_readFromRingThreadRunning.store(false);
+                try {
+                    if (m_readFromRingThread.joinable()) {
+                        m_readFromRingThread.join();
+                    }
+                } catch (...) {} // LCOV_EXCL_LINE
+                retry = (Claim::REMOVED == m_claim.load());
+                if (!retry) {
+                    std::cerr << "[cluon::LocalTransport] Failed to attach to shared memory '" << m_name << "'; using UDP multicast only." << std::endl;
+                }
+                unmapSharedMemory();
+            }
+        }
+    }
+    if (isRunning()) {
+        m_watchThreadRunning.store(true);
+        try {
+            m_watchThread = std::thread(&LocalTransport::watchLocalReceivers, this);
+        } catch (...) {
+            // LCOV_EXCL_START
+            m_watchThreadRunning.store(false);
+            m_readFromRingThreadRunning.store(false);
+            m_header->m_futex.fetch_add(1);
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_futex)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); // NOLINT
+            try {
+                m_readFromRingThread.join();
+            } catch (...) {}
+            unmapSharedMemory();
+            // LCOV_EXCL_STOP
+        }
+    } else if (retry) {
+        std::cerr << "[cluon::LocalTransport] Failed to attach to shared memory '" << m_name << "' as it was removed repeatedly; using UDP multicast only." << std::endl;
+    }
+    if (!isRunning()) {
+        m_pipeline.reset();
+    }
+#else
+    (void)CID;
+#endif
+}
+
+inline LocalTransport::~LocalTransport() noexcept {
+#ifdef __linux__
+    if (nullptr != m_header) {
+        m_readFromRingThreadRunning.store(false);
+        // Change the futex word so that the reader cannot go to sleep anymore and wake it.
+        m_header->m_futex.fetch_add(1);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_futex)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); // NOLINT
+        {
+            std::lock_guard<std::mutex> lck(m_watchMutex);
+            m_watchThreadRunning.store(false);
+        }
+        m_watchCondition.notify_all();
+        try {
+            // The reading thread releases the slot before it ends; it might wait for the delegate to free a place in the pipeline.
+            if (m_readFromRingThread.joinable()) {
+                m_readFromRingThread.join();
+            }
+            if (m_watchThread.joinable()) {
+                m_watchThread.join();
+            }
+        } catch (...) {} // LCOV_EXCL_LINE
+
+        m_pipeline.reset();
+        unmapSharedMemory();
+    }
+#endif
+    m_header = nullptr;
+}
+
+#ifdef __linux__
+inline bool LocalTransport::mapSharedMemory(bool &retry) noexcept {
+    retry = false;
+    // The ring starts cache-line aligned behind the header.
+    constexpr std::size_t RING_OFFSET{(sizeof(Header) + 63) & ~static_cast<std::size_t>(63)};
+    m_mappedSize = RING_OFFSET + Header::CAPACITY;
+
+    bool created{false};
+    m_fd = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (-1 != m_fd) {
+        created = (0 == ::ftruncate(m_fd, static_cast<off_t>(m_mappedSize)));
+    } else if (EEXIST == errno) {
+        m_fd = ::shm_open(m_name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+        // The last OD4Session might have removed the shared memory in between.
+        retry = ((-1 == m_fd) && (ENOENT == errno));
+    }
+    if (-1 == m_fd) {
+        if (!retry) {
+            std::cerr << "[cluon::LocalTransport] Failed to open shared memory '" << m_name << "': " << ::strerror(errno) << " (" << errno << ")" << std::endl;
+        }
+        return false;
+    }
+
+    // Wait for the creator to size and initialize the shared memory.
+    const auto DEADLINE{std::chrono::steady_clock::now() + std::chrono::seconds(1)};
+    struct stat status {};
+    while (!created && (0 == ::fstat(m_fd, &status)) && (static_cast<std::size_t>(status.st_size) != m_mappedSize)
+           && (std::chrono::steady_clock::now() < DEADLINE)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (created || (static_cast<std::size_t>(status.st_size) == m_mappedSize)) {
+        void *sharedMemory{::mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0)};
+        if (MAP_FAILED != sharedMemory) {
+            m_sharedMemory = static_cast<char *>(sharedMemory);
+            m_header       = reinterpret_cast<Header *>(m_sharedMemory); // NOLINT
+            m_ring         = m_sharedMemory + RING_OFFSET;
+        }
+    }
+    bool mapped{false};
+    if (nullptr != m_header) {
+        if (created) {
+            // ftruncate zeroed the shared memory, which is the initial state of all counters and peers.
+            static_assert(std::is_trivially_default_constructible<Header>::value, "The shared memory is initialized by zeroing it.");
+            pthread_mutexattr_t mutexAttribute;
+            ::pthread_mutexattr_init(&mutexAttribute);
+            ::pthread_mutexattr_setpshared(&mutexAttribute, PTHREAD_PROCESS_SHARED);
+            ::pthread_mutexattr_setrobust(&mutexAttribute, PTHREAD_MUTEX_ROBUST);
+            ::pthread_mutex_init(&(m_header->m_writerMutex), &mutexAttribute);
+            for (auto &peer : m_header->m_peers) {
+                ::pthread_mutex_init(&(peer.m_alive), &mutexAttribute);
+            }
+            ::pthread_mutexattr_destroy(&mutexAttribute);
+            m_header->m_capacity = static_cast<uint32_t>(Header::CAPACITY);
+            m_header->m_magic.store(Header::MAGIC, std::memory_order_release);
+        }
+        while ((Header::MAGIC != m_header->m_magic.load(std::memory_order_acquire)) && (std::chrono::steady_clock::now() < DEADLINE)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        mapped = (Header::MAGIC == m_header->m_magic.load(std::memory_order_acquire)) && (Header::CAPACITY == m_header->m_capacity);
+        if (!mapped) {
+            std::cerr << "[cluon::LocalTransport] Failed to attach to shared memory '" << m_name << "'; using UDP multicast only." << std::endl;
+        }
+    }
+
+    if (!mapped) {
+        unmapSharedMemory();
+    }
+    return mapped;
+}
+
+inline void LocalTransport::unmapSharedMemory() noexcept {
+    if (nullptr != m_sharedMemory) {
+        ::munmap(m_sharedMemory, m_mappedSize);
+    }
+    if (-1 != m_fd) {
+        ::close(m_fd);
+    }
+    m_sharedMemory = nullptr;
+    m_header       = nullptr;
+    m_ring         = nullptr;
+    m_fd           = -1;
+}
+
+inline bool LocalTransport::lockWriterMutex() noexcept {
+    int32_t result{::pthread_mutex_lock(&(m_header->m_writerMutex))};
+    if (EOWNERDEAD == result) {
+        // The previous owner died while holding the mutex; discard a datagram it was writing.
+        m_header->m_reserved.store(m_header->m_committed.load());
+        result = ::pthread_mutex_consistent(&(m_header->m_writerMutex));
+    }
+    return (0 == result);
+}
+
+inline bool LocalTransport::claimSlot() noexcept {
+    for (std::size_t i{0}; i < Header::NUMBER_OF_PEERS; i++) {
+        Header::Peer &peer = m_header->m_peers[i];
+        if (!isAttached(i)) {
+            int32_t result{::pthread_mutex_trylock(&(peer.m_alive))};
+            if (EOWNERDEAD == result) {
+                result = ::pthread_mutex_consistent(&(peer.m_alive));
+            }
+            if (0 == result) {
+                peer.m_sendFromPort.store(m_sendFromPort);
+                peer.m_socketInode.store(m_socketInode.load());
+                peer.m_readPosition.store(m_header->m_committed.load());
+                peer.m_owner.store(m_owner);
+                m_slot = i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline void LocalTransport::releaseSlot() noexcept {
+    Header::Peer &peer = m_header->m_peers[m_slot];
+    const bool LOCKED{lockWriterMutex()};
+    peer.m_owner.store(0);
+    ::pthread_mutex_unlock(&(peer.m_alive));
+    if (LOCKED) {
+        // Remove the shared memory with the last attached OD4Session.
+        bool isLast{true};
+        for (std::size_t i{0}; i < Header::NUMBER_OF_PEERS; i++) {
+            isLast &= !isAttached(i);
+        }
+        if (isLast) {
+            ::shm_unlink(m_name.c_str());
+        }
+        ::pthread_mutex_unlock(&(m_header->m_writerMutex));
+    }
+}
+
+inline bool LocalTransport::isAttached(std::size_t slot) const noexcept {
+    Header::Peer &peer = m_header->m_peers[slot];
+    if (0 == peer.m_owner.load()) {
+        return false;
+    }
+    int32_t result{::pthread_mutex_trylock(&(peer.m_alive))};
+    if (EBUSY == result) {
+        return true;
+    }
+    if (EOWNERDEAD == result) {
+        result = ::pthread_mutex_consistent(&(peer.m_alive));
+    }
+    if (0 == result) {
+        // The owner died or is just detaching; nobody can claim the slot while m_alive is held.
+        peer.m_owner.store(0);
+        ::pthread_mutex_unlock(&(peer.m_alive));
+    }
+    return false;
+}
+
+inline void LocalTransport::waitForReaders(uint64_t end) noexcept {
+    auto now = []() {
+        return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+    const int64_t DEADLINE{now() + Header::BACKPRESSURE_TIMEOUT_IN_NANOSECONDS};
+    for (std::size_t i{0}; i < Header::NUMBER_OF_PEERS; i++) {
+        Header::Peer &peer = m_header->m_peers[i];
+        while (i != m_slot) {
+            // A reader that kept a writer waiting until the timeout is only waited for again once it has read on.
+            const uint64_t READ{peer.m_readPosition.load()};
+            if ((0 == peer.m_owner.load()) || (end - READ <= Header::CAPACITY) || (m_laggingReaders[i] == READ) || !isAttached(i)) {
+                break;
+            }
+            const int64_t REMAINING{DEADLINE - now()};
+            if (0 >= REMAINING) {
+                m_laggingReaders[i] = READ;
+                m_numberOfBackpressureTimeouts.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            // The reader wakes the writers after publishing its read position if it sees them waiting.
+            const uint32_t PROGRESS{m_header->m_progress.load()};
+            m_header->m_writersWaiting.fetch_add(1);
+            if (READ == peer.m_readPosition.load()) {
+                struct timespec timeout {};
+                timeout.tv_sec  = static_cast<time_t>(REMAINING / 1000000000L);
+                timeout.tv_nsec = static_cast<long>(REMAINING % 1000000000L);
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_progress)), FUTEX_WAIT, PROGRESS, &timeout, nullptr, 0); // NOLINT
+            }
+            m_header->m_writersWaiting.fetch_sub(1);
+        }
+    }
+}
+
+inline std::vector<char> LocalTransport::acquireBuffer() noexcept {
+    std::vector<char> buffer;
+    try {
+        std::lock_guard<std::mutex> lck(m_bufferPoolMutex);
+        if (!m_bufferPool.empty()) {
+            buffer = std::move(m_bufferPool.back());
+            m_bufferPool.pop_back();
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return buffer;
+}
+
+inline void LocalTransport::releaseBuffer(std::vector<char> &&buffer) noexcept {
+    try {
+        std::lock_guard<std::mutex> lck(m_bufferPoolMutex);
+        if (m_bufferPool.size() < MAX_POOLED_BUFFERS) {
+            buffer.clear();
+            m_bufferPool.push_back(std::move(buffer));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+#endif
+
+inline bool LocalTransport::isRunning() const noexcept {
+    return m_readFromRingThreadRunning.load();
+}
+
+inline void LocalTransport::registerReceiveSocket(uint64_t socketInode) noexcept {
+#ifdef __linux__
+    m_socketInode.store(socketInode);
+    if (isRunning()) {
+        m_header->m_peers[m_slot].m_socketInode.store(socketInode);
+    }
+#else
+    (void)socketInode;
+#endif
+}
+
+inline bool LocalTransport::send(const char *data, std::size_t size) noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    if ((nullptr != m_header) && (nullptr != data) && (0 < size) && (MAX_LENGTH >= size)) {
+        const uint64_t RECORD_SIZE{(sizeof(Header::Record) + size + 7) & ~static_cast<uint64_t>(7)};
+
+        if (lockWriterMutex()) {
+            uint64_t position{m_header->m_committed.load(std::memory_order_relaxed)};
+            uint64_t offset{position % Header::CAPACITY};
+            // A datagram does not wrap around; the rest of the ring is skipped instead.
+            const bool WRAP_AROUND{offset + RECORD_SIZE > Header::CAPACITY};
+            const uint64_t END{position + RECORD_SIZE + (WRAP_AROUND ? Header::CAPACITY - offset : 0)};
+            waitForReaders(END);
+
+            // Claim the bytes before overwriting them.
+            m_header->m_reserved.store(END, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            if (WRAP_AROUND) {
+                const Header::Record SKIP{Header::WRAP_AROUND, 0};
+                std::memcpy(m_ring + offset, &SKIP, sizeof(SKIP));
+                position += Header::CAPACITY - offset;
+                offset = 0;
+            }
+            const Header::Record RECORD{static_cast<uint32_t>(size), m_sendFromPort};
+            std::memcpy(m_ring + offset, &RECORD, sizeof(RECORD));
+            std::memcpy(m_ring + offset + sizeof(RECORD), data, size);
+            m_header->m_committed.store(END, std::memory_order_release);
+            ::pthread_mutex_unlock(&(m_header->m_writerMutex));
+
+            m_header->m_futex.fetch_add(1);
+            if (0 < m_header->m_waiters.load()) {
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_futex)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); // NOLINT
+            }
+            retVal = true;
+        }
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+    return retVal;
+}
+
+inline bool LocalTransport::allLocalReceiversAttached() noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    if (m_watchThreadRunning.load()) {
+        const int64_t PERIOD{Header::CHECK_PERIOD_IN_NANOSECONDS};
+        const int64_t NOW{std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()};
+        if (NOW - m_lastCheckRequest.load(std::memory_order_relaxed) > PERIOD) {
+            m_lastCheckRequest.store(NOW, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lck(m_watchMutex);
+                m_checkRequested = true;
+            }
+            m_watchCondition.notify_all();
+        }
+        // After a pause, the loopback stays on until the receivers were looked up again.
+        retVal = m_allLocalReceiversAttached.load() && (NOW - m_lastCheck.load() <= 2 * PERIOD);
+    }
+#endif
+    return retVal;
+}
+
+inline bool LocalTransport::checkLocalReceivers() const noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    if (nullptr != m_header) {
+        try {
+            std::ifstream procNetUDP{"/proc/net/udp"};
+            if (procNetUDP.good()) {
+                // Receive sockets of the attached OD4Sessions.
+                std::set<uint64_t> attachedSockets;
+                for (std::size_t i{0}; i < Header::NUMBER_OF_PEERS; i++) {
+                    if (isAttached(i)) {
+                        attachedSockets.insert(m_header->m_peers[i].m_socketInode.load());
+                    }
+                }
+
+                // Every socket receiving the multicast group, i.e., bound to the group's or any address, must be attached.
+                // At least our own receive socket is listed; otherwise, the file could not be read as expected.
+                const std::string ANY_ADDRESS{"00000000" + m_groupAddressInProcNetUDP.substr(8)};
+                bool foundReceiver{false};
+                bool foundUnattachedReceiver{false};
+                std::string line;
+                std::getline(procNetUDP, line);
+                while (std::getline(procNetUDP, line)) {
+                    std::istringstream sstr{line};
+                    std::string slot, localAddress, remoteAddress, state, queues, timer, retransmits, uid, timeout;
+                    uint64_t inode{0};
+                    sstr >> slot >> localAddress >> remoteAddress >> state >> queues >> timer >> retransmits >> uid >> timeout >> inode;
+                    if ((m_groupAddressInProcNetUDP == localAddress) || (ANY_ADDRESS == localAddress)) {
+                        foundReceiver = true;
+                        foundUnattachedReceiver |= (0 == attachedSockets.count(inode));
+                    }
+                }
+                retVal = foundReceiver && !foundUnattachedReceiver;
+            }
+        } catch (...) {
+            retVal = false; // LCOV_EXCL_LINE
+        }
+    }
+#endif
+    return retVal;
+}
+
+inline bool LocalTransport::isAttachedSender(const struct sockaddr_in &sender) const noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    if ((nullptr != m_header) && (0 < m_listOfLocalIPAddresses.count(sender.sin_addr.s_addr))) {
+        const uint32_t PORT{ntohs(sender.sin_port)};
+        for (std::size_t i{0}; (i < Header::NUMBER_OF_PEERS) && !retVal; i++) {
+            retVal = ((PORT == m_header->m_peers[i].m_sendFromPort.load()) && isAttached(i));
+        }
+    }
+#else
+    (void)sender;
+#endif
+    return retVal;
+}
+
+inline uint64_t LocalTransport::numberOfReceivedDatagrams() const noexcept {
+    return m_numberOfReceivedDatagrams.load(std::memory_order_relaxed);
+}
+
+inline uint64_t LocalTransport::numberOfOverruns() const noexcept {
+    return m_numberOfOverruns.load(std::memory_order_relaxed);
+}
+
+inline uint64_t LocalTransport::numberOfBackpressureTimeouts() const noexcept {
+    return m_numberOfBackpressureTimeouts.load(std::memory_order_relaxed);
+}
+
+inline void LocalTransport::watchLocalReceivers() noexcept {
+#ifdef __linux__
+    std::unique_lock<std::mutex> lck(m_watchMutex);
+    while (m_watchThreadRunning.load()) {
+        m_watchCondition.wait(lck, [this] { return (m_checkRequested || !m_watchThreadRunning.load()); });
+        if (m_checkRequested) {
+            m_checkRequested = false;
+            lck.unlock();
+            m_allLocalReceiversAttached.store(checkLocalReceivers());
+            m_lastCheck.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            lck.lock();
+        }
+    }
+#endif
+}
+
+inline void LocalTransport::readFromRing() noexcept {
+#ifdef __linux__
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    Tracer::instance().setThreadName("cluon::LocalTransport");
+
+    uint64_t readPosition{0};
+    {
+        Claim claim{Claim::FAILED};
+        if (lockWriterMutex()) {
+            // The shared memory is only removed while holding the mutex; a removed one is not attached to anymore.
+            struct stat status {};
+            if ((0 == ::fstat(m_fd, &status)) && (0 == status.st_nlink)) {
+                claim = Claim::REMOVED;
+            } else if (claimSlot()) {
+                claim = Claim::CLAIMED;
+                // Only datagrams written after attaching are read.
+                readPosition = m_header->m_committed.load(std::memory_order_relaxed);
+            }
+            ::pthread_mutex_unlock(&(m_header->m_writerMutex));
+        }
+        m_claim.store(claim);
+        if (Claim::CLAIMED != claim) {
+            return;
+        }
+    }
+
+    // Publishes how far this reader has read and wakes the writers waiting for it.
+    Header::Peer &self = m_header->m_peers[m_slot];
+    auto readOnTo = [this, &self, &readPosition](uint64_t position) {
+        readPosition = position;
+        self.m_readPosition.store(position);
+        if (0 < m_header->m_writersWaiting.load()) {
+            m_header->m_progress.fetch_add(1);
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_progress)), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); // NOLINT
+        }
+    };
+
+    // Datagrams queued in the pipeline since its thread was notified last; notified when the ring
+    // is drained and in between every BATCH_SIZE datagrams, like UDPReceiver's recvmmsg batches.
+    constexpr uint32_t BATCH_SIZE{16};
+    uint32_t queued{0};
+    while (m_readFromRingThreadRunning.load()) {
+        const uint32_t SEQUENCE{m_header->m_futex.load(std::memory_order_acquire)};
+
+        const uint64_t COMMITTED{m_header->m_committed.load(std::memory_order_acquire)};
+        if (readPosition == COMMITTED) {
+            if (0 < queued) {
+                m_pipeline->notifyAll();
+                queued = 0;
+            }
+            // Sleep until the next datagram without a timeout; a changed futex word returns immediately,
+            // and the destructor changes it to stop this thread.
+            m_header->m_waiters.fetch_add(1);
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&(m_header->m_futex)), FUTEX_WAIT, SEQUENCE, nullptr, nullptr, 0); // NOLINT
+            m_header->m_waiters.fetch_sub(1);
+            continue;
+        }
+        if (COMMITTED - readPosition > Header::CAPACITY) {
+            // The writers have overtaken this reader.
+            m_numberOfOverruns.fetch_add(1, std::memory_order_relaxed);
+            readOnTo(COMMITTED);
+            continue;
+        }
+
+        const uint64_t OFFSET{readPosition % Header::CAPACITY};
+        Header::Record record{0, 0};
+        std::memcpy(&record, m_ring + OFFSET, sizeof(record));
+        uint64_t recordSize{0};
+        bool isDatagram{false};
+        PipelineEntry entry;
+        if (Header::WRAP_AROUND == record.m_length) {
+            recordSize = Header::CAPACITY - OFFSET;
+        } else if ((0 < record.m_length) && (MAX_LENGTH >= record.m_length) && (OFFSET + sizeof(record) + record.m_length <= Header::CAPACITY)) {
+            recordSize = (sizeof(record) + record.m_length + 7) & ~static_cast<uint64_t>(7);
+            isDatagram = (m_sendFromPort != record.m_sendFromPort);
+            if (isDatagram) {
+                try {
+                    // A recycled buffer only allocates if it has never held a datagram this large.
+                    entry.m_data = acquireBuffer();
+                    entry.m_data.assign(m_ring + OFFSET + sizeof(record), m_ring + OFFSET + sizeof(record) + record.m_length);
+                } catch (...) {
+                    isDatagram = false; // LCOV_EXCL_LINE
+                }
+            }
+        }
+
+        // The copy is only valid if no writer has claimed these bytes again meanwhile.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((0 == recordSize) || (m_header->m_reserved.load(std::memory_order_relaxed) - readPosition > Header::CAPACITY)) {
+            m_numberOfOverruns.fetch_add(1, std::memory_order_relaxed);
+            if (isDatagram) {
+                releaseBuffer(std::move(entry.m_data));
+            }
+            readOnTo(m_header->m_committed.load(std::memory_order_acquire));
+            continue;
+        }
+        readOnTo(readPosition + recordSize);
+
+        if (isDatagram) {
+            m_numberOfReceivedDatagrams.fetch_add(1, std::memory_order_relaxed);
+            entry.m_sendFromPort = static_cast<uint16_t>(record.m_sendFromPort);
+            entry.m_sampleTime   = std::chrono::system_clock::now();
+            m_pipeline->add(std::move(entry));
+            if (BATCH_SIZE == ++queued) {
+                m_pipeline->notifyAll();
+                queued = 0;
+            }
+        }
+    }
+    releaseSlot();
+#endif
+}
+
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -13933,7 +17204,12 @@ inline void ToMsgPackVisitor::visit(uint32_t id, std::string &&typeName, std::st
 //#include "cluon/FromProtoVisitor.hpp"
 //#include "cluon/TerminateHandler.hpp"
 //#include "cluon/Time.hpp"
+//#include "cluon/UDPPacketSizeConstraints.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -13944,92 +17220,405 @@ inline OD4Session::OD4Session(uint16_t CID, std::function<void(cluon::data::Enve
     : m_receiver{nullptr}
     , m_sender{"225.0.0." + std::to_string(CID), 12175}
     , m_delegate(std::move(delegate))
-    , m_mapOfDataTriggeredDelegatesMutex{}
-    , m_mapOfDataTriggeredDelegates{} {
+    , m_mapOfDataTriggeredDelegates{}
+    , m_mapOfDispatchLanes{}
+    , m_decodeWorkers{} {
+    // OD4Sessions on this host exchange their datagrams through shared memory; it is attached
+    // first so that no datagram from an attached OD4Session is received via UDP only.
+    try {
+        m_localTransport = std::make_unique<cluon::LocalTransport>(
+            CID, m_sender.getSendFromPort(), [this](const char *data, std::size_t size, uint16_t sendFromPort, std::chrono::system_clock::time_point sampleTime) {
+                struct sockaddr_in sender {};
+                sender.sin_family      = AF_INET;
+                sender.sin_port        = htons(sendFromPort);
+                sender.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                std::lock_guard<std::mutex> lck(this->m_callbackMutex);
+                this->callback(cluon::UDPDatagram{data, size, sender, sampleTime});
+            });
+        if (!m_localTransport->isRunning()) {
+            m_localTransport.reset();
+        }
+    } catch (...) {
+        m_localTransport.reset(); // LCOV_EXCL_LINE
+    }
+
     m_receiver = std::make_unique<cluon::UDPReceiver>(
         "225.0.0." + std::to_string(CID),
         12175,
-        [this](std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) {
-            this->callback(std::move(data), std::move(from), std::move(timepoint));
+        [this](const cluon::UDPDatagram &datagram) {
+            // Datagrams from attached OD4Sessions arrive through the shared memory already.
+            if (!(this->m_localTransport && this->m_localTransport->isAttachedSender(datagram.sender()))) {
+                std::lock_guard<std::mutex> lck(this->m_callbackMutex);
+                this->callback(datagram);
+            }
         },
         m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */);
+    if (m_localTransport) {
+        m_localTransport->registerReceiveSocket(m_receiver->socketInode());
+    }
 }
 
-inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate) noexcept {
+inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate, OverrunPolicy overrunPolicy) noexcept {
     if (nullptr != delegate) {
+        m_timeTriggerActivations.store(0);
+        m_timeTriggerOverruns.store(0);
+        m_timeTriggerSkippedActivations.store(0);
+        m_timeTriggerJitterSumInNanoseconds.store(0);
+        m_timeTriggerMaxJitterInNanoseconds.store(0);
+
+        // Monotonic time in nanoseconds; unaffected by adjustments of the wall clock.
+        auto monotonicNow = []() {
+            return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        };
+        // Sleep until the given absolute deadline.
+        auto sleepUntil = [](int64_t deadlineInNanoseconds) {
+#if defined(WIN32) || defined(__APPLE__)
+            std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineInNanoseconds)));
+#else
+            // std::chrono::steady_clock is based on CLOCK_MONOTONIC.
+            struct timespec deadline;
+            deadline.tv_sec  = static_cast<time_t>(deadlineInNanoseconds / 1000000000L);
+            deadline.tv_nsec = static_cast<long>(deadlineInNanoseconds % 1000000000L);
+            while (EINTR == ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr)) {}
+#endif
+        };
+
         bool delegateIsRunning{true};
-        const int64_t TIME_SLICE_IN_MILLISECONDS{static_cast<uint32_t>(1000 / ((freq > 0) ? freq : 1.0f))};
+        const int64_t PERIOD_IN_NANOSECONDS{static_cast<int64_t>(1000000000.0 / ((freq > 0) ? static_cast<double>(freq) : 1.0))};
+        int64_t deadline{monotonicNow()};
         do {
-            cluon::data::TimeStamp before{cluon::time::now()};
+            const int64_t JITTER{std::max<int64_t>(0, monotonicNow() - deadline)};
+            m_timeTriggerActivations.fetch_add(1, std::memory_order_relaxed);
+            m_timeTriggerJitterSumInNanoseconds.fetch_add(JITTER, std::memory_order_relaxed);
+            if (JITTER > m_timeTriggerMaxJitterInNanoseconds.load(std::memory_order_relaxed)) {
+                m_timeTriggerMaxJitterInNanoseconds.store(JITTER, std::memory_order_relaxed);
+            }
+
             try {
                 delegateIsRunning = delegate();
             } catch (...) {
                 delegateIsRunning = false; // delegate threw exception.
             }
-            cluon::data::TimeStamp after{cluon::time::now()};
-
-            const int64_t beforeInMicroseconds{cluon::time::toMicroseconds(before)};
-            const int64_t afterInMicroseconds{cluon::time::toMicroseconds(after)};
-
-            const int64_t timeSpent{(afterInMicroseconds > beforeInMicroseconds) ? (afterInMicroseconds - beforeInMicroseconds) / 1000 : 0};
-            const int64_t timeToSleepInMilliseconds{TIME_SLICE_IN_MILLISECONDS - timeSpent};
+            if (m_flushAfterTimeTrigger.load(std::memory_order_relaxed)) {
+                flush();
+            }
 
-            // Sleep the remaining time.
-            if ((timeToSleepInMilliseconds > 0) && (timeToSleepInMilliseconds <= TIME_SLICE_IN_MILLISECONDS)) {
-                std::this_thread::sleep_for(std::chrono::duration<int64_t, std::milli>(timeToSleepInMilliseconds));
-            } else {
+            deadline += PERIOD_IN_NANOSECONDS;
+            const int64_t NOW{monotonicNow()};
+            if (NOW > deadline) {
+                m_timeTriggerOverruns.fetch_add(1, std::memory_order_relaxed);
                 std::cerr << "[cluon::OD4Session]: time-triggered delegate violated allocated time slice." << std::endl;
+                if (OverrunPolicy::SKIP == overrunPolicy) {
+                    // Continue with the next deadline in the future.
+                    const int64_t MISSED{(NOW - deadline) / PERIOD_IN_NANOSECONDS + 1};
+                    m_timeTriggerSkippedActivations.fetch_add(static_cast<uint64_t>(MISSED), std::memory_order_relaxed);
+                    deadline += MISSED * PERIOD_IN_NANOSECONDS;
+                }
+            }
+            if (delegateIsRunning) {
+                sleepUntil(deadline);
             }
         } while (delegateIsRunning && !TerminateHandler::instance().isTerminated.load());
     }
 }
 
+inline TimeTriggerStatistics OD4Session::timeTriggerStatistics() const noexcept {
+    TimeTriggerStatistics retVal;
+    retVal.m_numberOfActivations        = m_timeTriggerActivations.load(std::memory_order_relaxed);
+    retVal.m_numberOfOverruns           = m_timeTriggerOverruns.load(std::memory_order_relaxed);
+    retVal.m_numberOfSkippedActivations = m_timeTriggerSkippedActivations.load(std::memory_order_relaxed);
+    retVal.m_meanJitterInNanoseconds
+        = (0 < retVal.m_numberOfActivations) ? m_timeTriggerJitterSumInNanoseconds.load(std::memory_order_relaxed) / static_cast<int64_t>(retVal.m_numberOfActivations) : 0;
+    retVal.m_maxJitterInNanoseconds = m_timeTriggerMaxJitterInNanoseconds.load(std::memory_order_relaxed);
+    return retVal;
+}
+
 inline bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept {
     bool retVal{false};
     if (nullptr == m_delegate) {
         try {
-            std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-            if ((nullptr == delegate) && (m_mapOfDataTriggeredDelegates.count(messageIdentifier) > 0)) {
-                auto element = m_mapOfDataTriggeredDelegates.find(messageIdentifier);
-                if (element != m_mapOfDataTriggeredDelegates.end()) {
-                    m_mapOfDataTriggeredDelegates.erase(element);
+            m_mapOfDataTriggeredDelegates.update([messageIdentifier, &delegate](MapOfDataTriggeredDelegates &delegates) {
+                if (nullptr == delegate) {
+                    delegates.erase(messageIdentifier);
+                } else {
+                    delegates[messageIdentifier] = std::move(delegate);
                 }
-            } else {
-                m_mapOfDataTriggeredDelegates[messageIdentifier] = delegate;
-            }
+            });
             retVal = true;
         } catch (...) {} // LCOV_EXCL_LINE
     }
     return retVal;
 }
 
-inline void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chrono::system_clock::time_point &&timepoint) noexcept {
-    size_t numberOfDataTriggeredDelegates{0};
-    {
-        try {
-            std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-            numberOfDataTriggeredDelegates = m_mapOfDataTriggeredDelegates.size();
-        } catch (...) {} // LCOV_EXCL_LINE
+inline OD4Session::~OD4Session() noexcept {
+    // Stop receiving before the delegates and dispatch lanes are destroyed.
+    m_receiver.reset();
+    m_localTransport.reset();
+}
+
+inline bool OD4Session::dispatchLane(const std::vector<int32_t> &messageIdentifiers,
+                                     std::size_t queueCapacity,
+                                     OverflowPolicy overflowPolicy,
+                                     int32_t priority) noexcept {
+    bool retVal{false};
+    try {
+        auto lane = std::make_shared<DispatchLane>(
+            [this](LaneEntry &&entry) { this->dispatch(entry.m_data.data(), entry.m_data.size(), entry.m_sampleTime); }, queueCapacity, overflowPolicy);
+        if ((0 != priority) && !lane->setPriority(priority)) {
+            std::cerr << "[cluon::OD4Session] Failed to set priority " << priority << " for dispatch lane: " << ::strerror(errno) << std::endl; // LCOV_EXCL_LINE
+        }
+
+        m_mapOfDispatchLanes.update([&messageIdentifiers, &lane](MapOfDispatchLanes &lanes) {
+            for (const int32_t messageIdentifier : messageIdentifiers) {
+                lanes[messageIdentifier] = lane;
+            }
+        });
+        retVal = true;
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline bool OD4Session::decodeWorkers(std::size_t numberOfWorkers, std::size_t queueCapacity, OverflowPolicy overflowPolicy) noexcept {
+    bool retVal{false};
+    try {
+        auto workers = std::make_shared<DecodeWorkers>();
+        for (std::size_t i{0}; i < numberOfWorkers; i++) {
+            auto worker = std::make_shared<DecodeWorker>();
+            DecodeWorker *w{worker.get()};
+            worker->m_pipeline = std::make_unique<DispatchLane>(
+                [this, w](LaneEntry &&entry) {
+                    const auto START{std::chrono::steady_clock::now()};
+                    this->dispatch(entry.m_data.data(), entry.m_data.size(), entry.m_sampleTime);
+                    w->m_busyTimeInNanoseconds.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - START).count(), std::memory_order_relaxed);
+                    w->m_numberOfDispatchedEnvelopes.fetch_add(1, std::memory_order_relaxed);
+                },
+                queueCapacity,
+                overflowPolicy);
+            workers->push_back(std::move(worker));
+        }
+
+        // The previous workers finish when they are reclaimed at the next callback.
+        m_decodeWorkers.update([&workers](DecodeWorkers &current) { current = std::move(*workers); });
+        retVal = true;
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline std::vector<DecodeWorkerStatistics> OD4Session::decodeWorkerStatistics() const noexcept {
+    std::vector<DecodeWorkerStatistics> retVal;
+    try {
+        m_decodeWorkers.inspect([&retVal](const DecodeWorkers &workers) {
+            for (const auto &worker : workers) {
+                DecodeWorkerStatistics statistics;
+                statistics.m_queueDepth                  = worker->m_pipeline->size();
+                statistics.m_queueHighWaterMark          = worker->m_pipeline->highWaterMark();
+                statistics.m_numberOfDispatchedEnvelopes = worker->m_numberOfDispatchedEnvelopes.load(std::memory_order_relaxed);
+                statistics.m_numberOfDroppedEnvelopes    = worker->m_pipeline->numberOfDroppedEntries();
+                statistics.m_busyTimeInNanoseconds       = worker->m_busyTimeInNanoseconds.load(std::memory_order_relaxed);
+                retVal.push_back(statistics);
+            }
+        });
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+inline void OD4Session::callback(const cluon::UDPDatagram &datagram) noexcept {
+    // Holding m_callbackMutex, no route is using a replaced dispatch lane or decode worker.
+    m_mapOfDispatchLanes.reclaim();
+    m_decodeWorkers.reclaim();
+
+    if ((FRAGMENT_HEADER_SIZE <= datagram.size()) && (0x0D == static_cast<uint8_t>(datagram.data()[0]))
+        && (0xA5 == static_cast<uint8_t>(datagram.data()[1]))) {
+        reassemble(datagram);
+        return;
+    }
+
+    // A datagram carries one Envelope or, from a peer packing Envelopes,
+    // several ones back to back; each one is routed on its own.
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    const char *data{datagram.data()};
+    std::size_t size{datagram.size()};
+    do {
+        std::size_t envelopeSize{size};
+        if ((OD4_HEADER_SIZE <= size) && (0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1]))) {
+            const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2]))
+                                     | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                                     | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+            envelopeSize = std::min(size, OD4_HEADER_SIZE + LENGTH);
+        }
+        route(data, envelopeSize, datagram.sampleTime());
+        data += envelopeSize;
+        size -= envelopeSize;
+    } while (0 < size);
+}
+
+inline void OD4Session::reassemble(const cluon::UDPDatagram &datagram) noexcept {
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    constexpr std::size_t FRAGMENT_SIZE{MAX_LENGTH - FRAGMENT_HEADER_SIZE};
+
+    const uint8_t *header{reinterpret_cast<const uint8_t *>(datagram.data())};
+    auto readLittleEndian = [header](std::size_t offset, std::size_t bytes) {
+        uint32_t value{0};
+        for (std::size_t i{0}; i < bytes; i++) {
+            value |= static_cast<uint32_t>(header[offset + i]) << (8 * i);
+        }
+        return value;
+    };
+    const uint32_t SEQUENCE_IDENTIFIER{readLittleEndian(2, 4)};
+    const std::size_t INDEX{readLittleEndian(6, 2)};
+    const std::size_t COUNT{readLittleEndian(8, 2)};
+    const std::size_t SIZE{readLittleEndian(10, 4)};
+    const std::size_t OFFSET{INDEX * FRAGMENT_SIZE};
+    // Every fragment but the last one is full.
+    if ((INDEX >= COUNT) || (SIZE > MAX_ENVELOPE_SIZE) || (COUNT != (SIZE + FRAGMENT_SIZE - 1) / FRAGMENT_SIZE)
+        || (datagram.size() - FRAGMENT_HEADER_SIZE != std::min(FRAGMENT_SIZE, SIZE - OFFSET))) {
+        return;
+    }
+
+    try {
+        const auto NOW = std::chrono::steady_clock::now();
+        const std::chrono::milliseconds TIMEOUT{m_reassemblyTimeoutInMilliseconds.load(std::memory_order_relaxed)};
+        const std::size_t MAXIMUM_MEMORY{m_maximumReassemblyMemory.load(std::memory_order_relaxed)};
+
+        // Remember a discarded Envelope so that its remaining fragments do not start it over.
+        auto discard = [this](const std::pair<uint64_t, uint32_t> &key) {
+            constexpr std::size_t REMEMBERED_DISCARDS{64};
+            m_numberOfDroppedReassemblies.fetch_add(1, std::memory_order_relaxed);
+            m_discardedReassemblies.push_back(key);
+            if (REMEMBERED_DISCARDS < m_discardedReassemblies.size()) {
+                m_discardedReassemblies.pop_front();
+            }
+        };
+
+        // Discard incomplete Envelopes whose fragments did not arrive in time.
+        for (auto it = m_reassemblies.begin(); it != m_reassemblies.end();) {
+            if (NOW - it->second.m_started > TIMEOUT) {
+                m_reassemblyMemory -= it->second.m_data.size();
+                discard(it->first);
+                it = m_reassemblies.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        const uint64_t SENDER{(static_cast<uint64_t>(datagram.sender().sin_addr.s_addr) << 16) | datagram.sender().sin_port};
+        const auto KEY = std::make_pair(SENDER, SEQUENCE_IDENTIFIER);
+        auto reassembly = m_reassemblies.find(KEY);
+        if (m_reassemblies.end() == reassembly) {
+            if (m_discardedReassemblies.end() != std::find(m_discardedReassemblies.begin(), m_discardedReassemblies.end(), KEY)) {
+                return;
+            }
+            if (SIZE > MAXIMUM_MEMORY) {
+                discard(KEY);
+                return;
+            }
+            // Make room by discarding the oldest incomplete Envelopes.
+            while (m_reassemblyMemory + SIZE > MAXIMUM_MEMORY) {
+                auto oldest = std::min_element(m_reassemblies.begin(), m_reassemblies.end(), [](const auto &a, const auto &b) {
+                    return a.second.m_started < b.second.m_started;
+                });
+                m_reassemblyMemory -= oldest->second.m_data.size();
+                discard(oldest->first);
+                m_reassemblies.erase(oldest);
+            }
+            Reassembly r;
+            r.m_data.resize(SIZE);
+            r.m_hasFragment.resize(COUNT, false);
+            r.m_missingFragments = COUNT;
+            r.m_started          = NOW;
+            reassembly           = m_reassemblies.emplace(KEY, std::move(r)).first;
+            m_reassemblyMemory += SIZE;
+        } else if (reassembly->second.m_data.size() != SIZE) {
+            return;
+        }
+
+        Reassembly &r{reassembly->second};
+        if (!r.m_hasFragment[INDEX]) {
+            std::memcpy(&r.m_data[OFFSET], datagram.data() + FRAGMENT_HEADER_SIZE, datagram.size() - FRAGMENT_HEADER_SIZE);
+            r.m_hasFragment[INDEX] = true;
+            r.m_missingFragments--;
+        }
+        if (0 == r.m_missingFragments) {
+            std::vector<char> data{std::move(r.m_data)};
+            m_reassemblyMemory -= SIZE;
+            m_reassemblies.erase(reassembly);
+            m_numberOfReassembledEnvelopes.fetch_add(1, std::memory_order_relaxed);
+            route(data.data(), data.size(), datagram.sampleTime());
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+inline void OD4Session::route(const char *data, std::size_t size, const std::chrono::system_clock::time_point &sampleTime) noexcept {
+    const MapOfDispatchLanes &lanes{m_mapOfDispatchLanes.get()};
+    const DecodeWorkers &workers{m_decodeWorkers.get()};
+    if (!lanes.empty() || !workers.empty()) {
+        std::pair<bool, int32_t> dataType{peekEnvelopeDataType(data, size)};
+        DispatchLane *pipeline{nullptr};
+        if (dataType.first) {
+            auto lane = lanes.find(dataType.second);
+            if (lanes.end() != lane) {
+                pipeline = lane->second.get();
+            }
+        }
+        if ((nullptr == pipeline) && !workers.empty()) {
+            // Envelopes of the same stream always go to the same worker to keep their order.
+            const uint64_t STREAM{(static_cast<uint64_t>(static_cast<uint32_t>(dataType.second)) << 32) | peekEnvelopeSenderStamp(data, size).second};
+            const std::size_t INDEX{static_cast<std::size_t>(((STREAM * 0x9E3779B97F4A7C15ULL) >> 32) % workers.size())};
+            pipeline = workers[INDEX]->m_pipeline.get();
+        }
+        if (nullptr != pipeline) {
+            try {
+                LaneEntry entry;
+                entry.m_data.assign(data, data + size);
+                entry.m_sampleTime = sampleTime;
+                pipeline->add(std::move(entry));
+                pipeline->notifyAll();
+            } catch (...) {} // LCOV_EXCL_LINE
+            return;
+        }
+    }
+    dispatch(data, size, sampleTime);
+}
+
+inline void OD4Session::dispatch(const char *data, std::size_t size, const std::chrono::system_clock::time_point &sampleTime) noexcept {
+    bool isSubscribed{nullptr != m_delegate};
+    MapOfDataTriggeredDelegates::const_iterator dataTriggeredDelegate;
+    if (!isSubscribed) {
+        // Peek at the dataType in the raw bytes to discard Envelopes without
+        // a data-triggered delegate before decoding them.
+        std::pair<bool, int32_t> dataType{peekEnvelopeDataType(data, size)};
+        if (dataType.first) {
+            const MapOfDataTriggeredDelegates &delegates{m_mapOfDataTriggeredDelegates.get()};
+            dataTriggeredDelegate = delegates.find(dataType.second);
+            isSubscribed          = (delegates.end() != dataTriggeredDelegate);
+            if (!isSubscribed) {
+                m_numberOfFilteredEnvelopes.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
     }
     // Only unpack the envelope when it needs to be post-processed.
-    if ((nullptr != m_delegate) || (0 < numberOfDataTriggeredDelegates)) {
-        std::stringstream sstr(data);
-        auto retVal = extractEnvelope(sstr);
+    if (isSubscribed) {
+        std::pair<std::size_t, cluon::data::Envelope> retVal;
+        {
+            TraceSpan span("OD4Session::decode", "cluon");
+            retVal = extractEnvelope(data, size);
+        }
 
-        if (retVal.first) {
-            cluon::data::Envelope env{retVal.second};
-            env.received(cluon::time::convert(timepoint));
+        if (0 < retVal.first) {
+            TraceSpan span("OD4Session::dispatch", "cluon");
+            cluon::data::Envelope env{std::move(retVal.second)};
+            env.received(cluon::time::convert(sampleTime));
 
             // "Catch all"-delegate.
             if (nullptr != m_delegate) {
                 m_delegate(std::move(env));
             } else {
                 try {
-                    // Data triggered-delegates.
-                    std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-                    if (m_mapOfDataTriggeredDelegates.count(env.dataType()) > 0) {
-                        m_mapOfDataTriggeredDelegates[env.dataType()](std::move(env));
-                    }
+                    // Data triggered-delegate found in the snapshot above.
+                    dataTriggeredDelegate->second(std::move(env));
                 } catch (...) {} // LCOV_EXCL_LINE
             }
         }
@@ -14041,13 +17630,174 @@ inline void OD4Session::send(cluon::data::Envelope &&envelope) noexcept {
 }
 
 inline void OD4Session::sendInternal(std::string &&dataToSend) noexcept {
-    m_sender.send(std::move(dataToSend));
+    std::lock_guard<std::mutex> lck(m_senderMutex);
+    sendEncoded(dataToSend.data(), dataToSend.size());
+}
+
+inline std::pair<ssize_t, int32_t> OD4Session::sendEncoded(const char *data, std::size_t size) noexcept {
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    // The length in the OD4 header was truncated; receivers would cut the Envelope short.
+    if (MAX_ENVELOPE_SIZE < size) {
+        return {-1, E2BIG};
+    }
+    const bool BATCH_SENDS{m_batchSends.load(std::memory_order_relaxed)};
+    std::pair<ssize_t, int32_t> retVal{0, 0};
+    // Close the current packed datagram when this Envelope does not fit anymore.
+    if (BATCH_SENDS && !m_packBuffer.empty() && (m_packBuffer.size() + size > m_maximumPackedDatagramSize)) {
+        sendDatagram(m_packBuffer.data(), m_packBuffer.size(), true);
+        m_packBuffer.clear();
+    }
+    if (MAX_LENGTH < size) {
+        retVal = sendFragments(data, size, BATCH_SENDS);
+    } else if (!BATCH_SENDS) {
+        retVal = sendDatagram(data, size, false);
+    } else {
+        if (size > m_maximumPackedDatagramSize) {
+            retVal = sendDatagram(data, size, true);
+        } else {
+            try {
+                m_packBuffer.append(data, size);
+            } catch (...) {
+                retVal = {-1, ENOMEM}; // LCOV_EXCL_LINE
+            }
+        }
+    }
+    if (0 == retVal.second) {
+        m_numberOfSentEnvelopes.fetch_add(1, std::memory_order_relaxed);
+    }
+    return retVal;
+}
+
+inline std::pair<ssize_t, int32_t> OD4Session::sendFragments(const char *data, std::size_t size, bool queue) noexcept {
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    constexpr std::size_t FRAGMENT_SIZE{MAX_LENGTH - FRAGMENT_HEADER_SIZE};
+    const std::size_t COUNT{(size + FRAGMENT_SIZE - 1) / FRAGMENT_SIZE};
+    if (COUNT > 0xFFFF) {
+        return {-1, E2BIG};
+    }
+
+    const uint32_t SEQUENCE_IDENTIFIER{m_nextSequenceIdentifier++};
+    auto appendLittleEndian = [this](uint32_t value, std::size_t bytes) {
+        for (std::size_t i{0}; i < bytes; i++) {
+            m_fragmentBuffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    };
+    ssize_t totalBytesSent{0};
+    try {
+        for (std::size_t index{0}; index < COUNT; index++) {
+            const std::size_t OFFSET{index * FRAGMENT_SIZE};
+            m_fragmentBuffer.clear();
+            m_fragmentBuffer.push_back(static_cast<char>(0x0D));
+            m_fragmentBuffer.push_back(static_cast<char>(0xA5));
+            appendLittleEndian(SEQUENCE_IDENTIFIER, 4);
+            appendLittleEndian(static_cast<uint32_t>(index), 2);
+            appendLittleEndian(static_cast<uint32_t>(COUNT), 2);
+            appendLittleEndian(static_cast<uint32_t>(size), 4);
+            m_fragmentBuffer.append(data + OFFSET, std::min(FRAGMENT_SIZE, size - OFFSET));
+
+            std::pair<ssize_t, int32_t> retVal{sendDatagram(m_fragmentBuffer.data(), m_fragmentBuffer.size(), queue)};
+            if (0 != retVal.second) {
+                return retVal;
+            }
+            totalBytesSent += retVal.first;
+        }
+    } catch (...) {
+        return {-1, ENOMEM}; // LCOV_EXCL_LINE
+    }
+    return {totalBytesSent, 0};
+}
+
+inline std::pair<ssize_t, int32_t> OD4Session::sendDatagram(const char *data, std::size_t size, bool queue) noexcept {
+    if (m_localTransport) {
+        m_localTransport->send(data, size);
+        // The multicast loopback is only needed for receivers on this host that are not attached
+        // to the shared memory, e.g., processes with an older libcluon; LocalTransport looks them up.
+        const bool MULTICAST_LOOPBACK{!m_localTransport->allLocalReceiversAttached()};
+        if (MULTICAST_LOOPBACK != m_multicastLoopback) {
+            m_multicastLoopback = MULTICAST_LOOPBACK;
+            m_sender.multicastLoopback(MULTICAST_LOOPBACK);
+        }
+    }
+    return (queue ? m_sender.queue(data, size) : m_sender.send(data, size));
+}
+
+inline void OD4Session::batchSends(bool enable, bool autoFlush) noexcept {
+    m_flushAfterTimeTrigger.store(enable && autoFlush);
+    m_batchSends.store(enable);
+    if (!enable) {
+        flush();
+    }
+}
+
+inline void OD4Session::flush() noexcept {
+    {
+        std::lock_guard<std::mutex> lck(m_senderMutex);
+        if (!m_packBuffer.empty()) {
+            sendDatagram(m_packBuffer.data(), m_packBuffer.size(), true);
+            m_packBuffer.clear();
+        }
+    }
+    m_sender.flush();
+}
+
+inline void OD4Session::reassemblyLimits(std::size_t maximumMemory, std::chrono::milliseconds timeout) noexcept {
+    m_maximumReassemblyMemory.store(maximumMemory);
+    m_reassemblyTimeoutInMilliseconds.store(static_cast<int64_t>(timeout.count()));
+}
+
+inline void OD4Session::packEnvelopes(std::size_t maximumDatagramSize) noexcept {
+    constexpr std::size_t MAX_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                       - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    std::lock_guard<std::mutex> lck(m_senderMutex);
+    // Envelopes packed so far keep their place in the queue.
+    if (!m_packBuffer.empty()) {
+        sendDatagram(m_packBuffer.data(), m_packBuffer.size(), true);
+        m_packBuffer.clear();
+    }
+    m_maximumPackedDatagramSize = std::min(maximumDatagramSize, MAX_LENGTH);
 }
 
 inline bool OD4Session::isRunning() noexcept {
     return m_receiver->isRunning();
 }
 
+inline uint64_t OD4Session::numberOfFilteredEnvelopes() const noexcept {
+    return m_numberOfFilteredEnvelopes.load(std::memory_order_relaxed);
+}
+
+inline uint64_t OD4Session::numberOfSentEnvelopes() const noexcept {
+    return m_numberOfSentEnvelopes.load(std::memory_order_relaxed);
+}
+
+inline uint64_t OD4Session::numberOfSentDatagrams() const noexcept {
+    return m_sender.numberOfSentPackets();
+}
+
+inline uint64_t OD4Session::numberOfReassembledEnvelopes() const noexcept {
+    return m_numberOfReassembledEnvelopes.load(std::memory_order_relaxed);
+}
+
+inline uint64_t OD4Session::numberOfDroppedReassemblies() const noexcept {
+    return m_numberOfDroppedReassemblies.load(std::memory_order_relaxed);
+}
+
+inline uint64_t OD4Session::numberOfSharedMemoryOverruns() const noexcept {
+    return (m_localTransport ? m_localTransport->numberOfOverruns() : 0);
+}
+
+inline uint64_t OD4Session::numberOfSharedMemoryBackpressureTimeouts() const noexcept {
+    return (m_localTransport ? m_localTransport->numberOfBackpressureTimeouts() : 0);
+}
+
+inline uint64_t OD4Session::numberOfSendCalls() const noexcept {
+    return m_sender.numberOfSendCalls();
+}
+
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -17065,6 +20815,17 @@ class LIBCLUON_API MetaMessageToCPPTransformator {
     MetaMessageToCPPTransformator()                                      = default;
     MetaMessageToCPPTransformator(const MetaMessageToCPPTransformator &) = default;
 
+    /**
+     * Constructor.
+     *
+     * @param withProtoCodec If true, every message additionally gets a constexpr
+     *        table of its fields and Proto encode/decode routines that visit the
+     *        fields by identifier only, i.e., without building type and field names.
+     * @param withViews If true, every message additionally gets a read-only view
+     *        type that locates its fields in the Proto-encoded bytes on access.
+     */
+    explicit MetaMessageToCPPTransformator(bool withProtoCodec, bool withViews = false) noexcept;
+
     /**
      * The method is called from MetaMessage to visit itself using this transformator.
      *
@@ -17078,6 +20839,8 @@ class LIBCLUON_API MetaMessageToCPPTransformator {
     std::string content() noexcept;
 
    private:
+    bool m_withProtoCodec{false};
+    bool m_withViews{false};
     kainjow::mustache::data m_dataToBeRendered{};
     kainjow::mustache::data m_fields{kainjow::mustache::data::type::list};
 };
@@ -17235,7 +20998,184 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+{{#%PROTO_CODEC%}}#ifndef MESSAGE_FIELD_INFO
+#define MESSAGE_FIELD_INFO
+#include <cstddef>
+#include <cstdint>
+
+// Entry of a message's field table: identifier, Proto wire type, type, and name.
+struct MessageFieldInfo {
+    uint32_t identifier;
+    uint8_t protoType;
+    const char *type;
+    const char *name;
+};
+#endif
+
+{{/%PROTO_CODEC%}}{{#%VIEWS%}}#ifndef PROTO_VIEW
+#define PROTO_VIEW
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Read-only reference to bytes inside a serialized message.
+class BytesView {
+    public:
+        BytesView() = default;
+        BytesView(const char *data, std::size_t size) noexcept : m_data{data}, m_size{size} {}
+        template<std::size_t N>
+        explicit BytesView(const char (&literal)[N]) noexcept : m_data{literal}, m_size{N - 1} {}
+
+        inline const char *data() const noexcept {
+            return m_data;
+        }
+        inline std::size_t size() const noexcept {
+            return m_size;
+        }
+        inline bool empty() const noexcept {
+            return 0 == m_size;
+        }
+        inline std::string str() const {
+            return std::string(m_data, m_size);
+        }
+
+    private:
+        const char *m_data{""};
+        std::size_t m_size{0};
+};
+
+// Locates the fields of a Proto-encoded message and reads them in place.
+struct ProtoView {
+    struct Field {
+        bool found;
+        uint8_t protoType;
+        uint64_t varInt;
+        const char *bytes;
+        std::size_t size;
+    };
+
+    static inline bool readVarInt(const char *&pos, const char *end, uint64_t &value) noexcept {
+        value = 0;
+        for (uint8_t shift{0}; (pos < end) && (shift < 64); shift = static_cast<uint8_t>(shift + 7)) {
+            const uint8_t c{static_cast<uint8_t>(*pos++)};
+            value |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if (0 == (c & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns the last occurrence of the given field like a decoder would.
+    static inline Field find(const char *data, std::size_t size, uint32_t id) noexcept {
+        Field retVal{false, 0, 0, nullptr, 0};
+        const char *pos{data};
+        const char *end{(nullptr != data) ? data + size : data};
+        uint64_t key{0};
+        while ((pos < end) && readVarInt(pos, end, key)) {
+            const uint8_t protoType{static_cast<uint8_t>(key & 0x7)};
+            uint64_t varInt{0};
+            const char *bytes{pos};
+            std::size_t length{0};
+            if (0 == protoType) {
+                if (!readVarInt(pos, end, varInt)) {
+                    break;
+                }
+            } else if ((1 == protoType) || (5 == protoType)) {
+                length = (1 == protoType) ? 8 : 4;
+                if (static_cast<std::size_t>(end - pos) < length) {
+                    break;
+                }
+                pos += length;
+            } else if (2 == protoType) {
+                if (!readVarInt(pos, end, varInt) || (static_cast<uint64_t>(end - pos) < varInt)) {
+                    break;
+                }
+                bytes  = pos;
+                length = static_cast<std::size_t>(varInt);
+                pos += length;
+            } else {
+                break;
+            }
+            if (id == (key >> 3)) {
+                retVal = Field{true, protoType, varInt, bytes, length};
+            }
+        }
+        return retVal;
+    }
+
+    template<typename S, typename U>
+    static inline S fromZigZag(U v) noexcept {
+        return static_cast<S>((v >> 1) ^ -(v & 1));
+    }
+
+    static inline uint64_t fromLittleEndian(const char *bytes, std::size_t size) noexcept {
+        uint64_t v{0};
+        for (std::size_t i{0}; i < size; i++) {
+            v |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[i])) << (8 * i);
+        }
+        return v;
+    }
+
+    static inline bool isVarInt(const Field &f) noexcept {
+        return f.found && (0 == f.protoType);
+    }
+
+    static inline void read(const Field &f, bool &v) noexcept {
+        if (isVarInt(f)) v = (0 != f.varInt);
+    }
+    static inline void read(const Field &f, char &v) noexcept {
+        if (isVarInt(f)) v = static_cast<char>(f.varInt);
+    }
+    static inline void read(const Field &f, int8_t &v) noexcept {
+        if (isVarInt(f)) v = fromZigZag<int8_t>(static_cast<uint8_t>(f.varInt));
+    }
+    static inline void read(const Field &f, uint8_t &v) noexcept {
+        if (isVarInt(f)) v = static_cast<uint8_t>(f.varInt);
+    }
+    static inline void read(const Field &f, int16_t &v) noexcept {
+        if (isVarInt(f)) v = fromZigZag<int16_t>(static_cast<uint16_t>(f.varInt));
+    }
+    static inline void read(const Field &f, uint16_t &v) noexcept {
+        if (isVarInt(f)) v = static_cast<uint16_t>(f.varInt);
+    }
+    static inline void read(const Field &f, int32_t &v) noexcept {
+        if (isVarInt(f)) v = fromZigZag<int32_t>(static_cast<uint32_t>(f.varInt));
+    }
+    static inline void read(const Field &f, uint32_t &v) noexcept {
+        if (isVarInt(f)) v = static_cast<uint32_t>(f.varInt);
+    }
+    static inline void read(const Field &f, int64_t &v) noexcept {
+        if (isVarInt(f)) v = fromZigZag<int64_t>(f.varInt);
+    }
+    static inline void read(const Field &f, uint64_t &v) noexcept {
+        if (isVarInt(f)) v = f.varInt;
+    }
+    static inline void read(const Field &f, float &v) noexcept {
+        if (f.found && (5 == f.protoType)) {
+            const uint32_t bits{static_cast<uint32_t>(fromLittleEndian(f.bytes, sizeof(float)))};
+            std::memcpy(&v, &bits, sizeof(float));
+        }
+    }
+    static inline void read(const Field &f, double &v) noexcept {
+        if (f.found && (1 == f.protoType)) {
+            const uint64_t bits{fromLittleEndian(f.bytes, sizeof(double))};
+            std::memcpy(&v, &bits, sizeof(double));
+        }
+    }
+    static inline void read(const Field &f, BytesView &v) noexcept {
+        if (f.found && (2 == f.protoType)) v = BytesView(f.bytes, f.size);
+    }
+    // Views of nested messages.
+    template<typename T>
+    static inline void read(const Field &f, T &v) noexcept {
+        if (f.found && (2 == f.protoType)) v = T(f.bytes, f.size);
+    }
+};
+#endif
 
+{{/%VIEWS%}}
 #ifndef {{%HEADER_GUARD%}}_HPP
 #define {{%HEADER_GUARD%}}_HPP
 
@@ -17258,7 +21198,8 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 
 #include <string>
 #include <utility>
-{{%NAMESPACE_OPENING%}}
+{{#%VIEWS%}}#include <cstddef>
+{{/%VIEWS%}}{{%NAMESPACE_OPENING%}}
 using namespace std::string_literals; // NOLINT
 class LIB_API {{%MESSAGE%}} {
     private:
@@ -17329,12 +21270,75 @@ class LIB_API {{%MESSAGE%}} {
             std::forward<PostVisitor>(postVisit)();
         }
 
-    private:
+{{#%PROTO_CODEC%}}    public:
+        inline static constexpr std::size_t NumberOfFields() {
+            return {{%NUMBER_OF_FIELDS%}};
+        }
+
+        inline static constexpr MessageFieldInfo FieldInfo(std::size_t index) {
+            (void)index;
+            {{#%FIELDS%}}
+            if ({{%FIELDINDEX%}} == index) {
+                return MessageFieldInfo{ {{%FIELDIDENTIFIER%}}, {{%PROTOTYPE%}}, "{{%TYPE%}}", "{{%NAME%}}" };
+            }
+            {{/%FIELDS%}}
+            return MessageFieldInfo{ 0, 0, "", "" };
+        }
+
+        // Proto codec: visits the fields by identifier only.
+        template<class Visitor>
+        inline void acceptProto(uint32_t fieldId, Visitor &visitor) {
+            (void)visitor;
+            switch (fieldId) {
+                {{#%FIELDS%}}
+                case {{%FIELDIDENTIFIER%}}: visitor.visit({{%FIELDIDENTIFIER%}}, m_{{%NAME%}}); break;
+                {{/%FIELDS%}}
+                default: break;
+            }
+        }
+
+        template<class Visitor>
+        inline void acceptProto(Visitor &visitor) {
+            (void)visitor;
+            {{#%FIELDS%}}
+            visitor.visit({{%FIELDIDENTIFIER%}}, m_{{%NAME%}});
+            {{/%FIELDS%}}
+        }
+
+{{/%PROTO_CODEC%}}    private:
         {{#%FIELDS%}}
         {{%TYPE%}} m_{{%NAME%}}{ {{%FIELD_DEFAULT_INITIALIZATION_VALUE%}}{{%INITIALIZER_SUFFIX%}} }; // field identifier = {{%FIELDIDENTIFIER%}}.
         {{/%FIELDS%}}
 };
-{{%NAMESPACE_CLOSING%}}
+{{#%VIEWS%}}
+
+// Read-only view of a Proto-encoded {{%MESSAGE%}}; every accessor locates its
+// field in the viewed bytes, which must outlive the view. Strings and bytes are
+// returned as BytesView into the viewed bytes.
+class LIB_API {{%MESSAGE%}}View {
+    public:
+        inline static int32_t ID() {
+            return {{%IDENTIFIER%}};
+        }
+
+    public:
+        {{%MESSAGE%}}View() = default;
+        {{%MESSAGE%}}View(const char *serializedData, std::size_t size) noexcept : m_serializedData{serializedData}, m_size{size} {}
+
+    public:
+        {{#%FIELDS%}}
+        inline {{%VIEW_TYPE%}} {{%NAME%}}() const noexcept {
+            {{%VIEW_TYPE%}} retVal{ {{%VIEW_DEFAULT%}} };
+            ProtoView::read(ProtoView::find(m_serializedData, m_size, {{%FIELDIDENTIFIER%}}), retVal);
+            return retVal;
+        }
+        {{/%FIELDS%}}
+
+    private:
+        const char *m_serializedData{nullptr};
+        std::size_t m_size{0};
+};
+{{/%VIEWS%}}{{%NAMESPACE_CLOSING%}}
 
 template<>
 struct isVisitable<{{%COMPLETEPACKAGENAME_WITH_COLON_SEPARATORS%}}{{%MESSAGE%}}> {
@@ -17347,8 +21351,15 @@ struct isTripletForwardVisitable<{{%COMPLETEPACKAGENAME_WITH_COLON_SEPARATORS%}}
 #endif
 )";
 
+MetaMessageToCPPTransformator::MetaMessageToCPPTransformator(bool withProtoCodec, bool withViews) noexcept
+    : m_withProtoCodec{withProtoCodec}
+    , m_withViews{withViews} {}
+
 std::string MetaMessageToCPPTransformator::content() noexcept {
     m_dataToBeRendered.set("%FIELDS%", m_fields);
+    m_dataToBeRendered.set("%PROTO_CODEC%",
+                           kainjow::mustache::data{m_withProtoCodec ? kainjow::mustache::data::type::bool_true : kainjow::mustache::data::type::bool_false});
+    m_dataToBeRendered.set("%VIEWS%", kainjow::mustache::data{m_withViews ? kainjow::mustache::data::type::bool_true : kainjow::mustache::data::type::bool_false});
 
     kainjow::mustache::mustache tmpl{headerFileTemplate};
     // Reset Mustache's default string-escaper.
@@ -17398,6 +21409,15 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
             {MetaMessage::MetaField::BYTES_T, R"("")"},
         };
 
+        // Values of cluon::ProtoConstants; the generated header does not depend on libcluon.
+        std::map<MetaMessage::MetaField::MetaFieldDataTypes, std::string> typeToProtoTypeMap = {
+            {MetaMessage::MetaField::FLOAT_T, "5"},
+            {MetaMessage::MetaField::DOUBLE_T, "1"},
+            {MetaMessage::MetaField::STRING_T, "2"},
+            {MetaMessage::MetaField::BYTES_T, "2"},
+            {MetaMessage::MetaField::MESSAGE_T, "2"},
+        };
+
         std::string namespacePrefix;
         std::string messageName{mm.messageName()};
         const auto pos = mm.messageName().find_last_of('.');
@@ -17423,7 +21443,9 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
         dataToBeRendered.set("%MESSAGE%", messageName);
         dataToBeRendered.set("%NAMESPACE_CLOSING%", namespaceFooter);
         dataToBeRendered.set("%IDENTIFIER%", std::to_string(mm.messageIdentifier()));
+        dataToBeRendered.set("%NUMBER_OF_FIELDS%", std::to_string(mm.listOfMetaFields().size()));
 
+        std::size_t fieldIndex{0};
         for (const auto &e : mm.listOfMetaFields()) {
             std::string fieldName{std::regex_replace(e.fieldName(), std::regex("\\."), "_")}; // NOLINT
             kainjow::mustache::data fieldEntry;
@@ -17442,13 +21464,22 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
                     initializerSuffix = "s"; // suffix to enforce std::string initialization.
                 }
                 fieldEntry.set("%INITIALIZER_SUFFIX%", initializerSuffix);
+
+                // Views return strings and bytes as BytesView into the viewed bytes.
+                const bool isStringOrBytes{(e.fieldDataType() == MetaMessage::MetaField::STRING_T) || (e.fieldDataType() == MetaMessage::MetaField::BYTES_T)};
+                fieldEntry.set("%VIEW_TYPE%", isStringOrBytes ? "BytesView" : typeToTypeStringMap[e.fieldDataType()]);
+                fieldEntry.set("%VIEW_DEFAULT%", defaultInitializatioValue + (isStringOrBytes ? "" : initializerSuffix));
             } else {
                 const std::string tmp{mm.packageName() + (!mm.packageName().empty() ? "." : "") + e.fieldDataTypeName()};
                 const std::string completeDataTypeNameWithDoubleColons{std::regex_replace(tmp, std::regex("\\."), "::")}; // NOLINT
 
                 fieldEntry.set("%TYPE%", completeDataTypeNameWithDoubleColons);
+                fieldEntry.set("%VIEW_TYPE%", completeDataTypeNameWithDoubleColons + "View");
+                fieldEntry.set("%VIEW_DEFAULT%", "");
             }
             fieldEntry.set("%FIELDIDENTIFIER%", std::to_string(e.fieldIdentifier()));
+            fieldEntry.set("%FIELDINDEX%", std::to_string(fieldIndex++));
+            fieldEntry.set("%PROTOTYPE%", (0 < typeToProtoTypeMap.count(e.fieldDataType())) ? typeToProtoTypeMap[e.fieldDataType()] : "0");
 
             fields.push_back(fieldEntry);
         }
@@ -17608,9 +21639,11 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
     if (std::string::npos != inputFilename.find(PROGRAM)) {
         std::cerr << PROGRAM
                   << " transforms a given message specification file in .odvd format into C++." << std::endl;
-        std::cerr << "Usage:   " << PROGRAM << " [--cpp] [--proto] [--out=<file>] <odvd file>" << std::endl;
-        std::cerr << "         " << PROGRAM << " --cpp:   Generate C++14-compliant, self-contained header file." << std::endl;
-        std::cerr << "         " << PROGRAM << " --proto: Generate Proto version2-compliant file." << std::endl;
+        std::cerr << "Usage:   " << PROGRAM << " [--cpp [--proto-codec] [--views]] [--proto] [--out=<file>] <odvd file>" << std::endl;
+        std::cerr << "         " << PROGRAM << " --cpp:         Generate C++14-compliant, self-contained header file." << std::endl;
+        std::cerr << "         " << PROGRAM << " --proto-codec: Add constexpr field tables and Proto encode/decode routines that do not build field names to the C++ header." << std::endl;
+        std::cerr << "         " << PROGRAM << " --views:       Add read-only views to the C++ header that access the fields of Proto-encoded messages in place." << std::endl;
+        std::cerr << "         " << PROGRAM << " --proto:       Generate Proto version2-compliant file." << std::endl;
         std::cerr << std::endl;
         std::cerr << "Example: " << PROGRAM << " --cpp --out=/tmp/myOutput.hpp myFile.odvd" << std::endl;
         return 1;
@@ -17620,6 +21653,8 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
     commandline({"--out"}) >> outputFilename;
 
     const bool generateCPP = commandline[{"--cpp"}];
+    const bool generateProtoCodec = commandline[{"--proto-codec"}];
+    const bool generateViews = commandline[{"--views"}];
     const bool generateProto = commandline[{"--proto"}];
 
     int retVal = 1;
@@ -17640,7 +21675,7 @@ inline int32_t cluon_msc(int32_t argc, char **argv) {
         for (auto e : result.first) {
             std::string content;
             if (generateCPP) {
-                cluon::MetaMessageToCPPTransformator transformation;
+                cluon::MetaMessageToCPPTransformator transformation{generateProtoCodec, generateViews};
                 e.accept([&trans = transformation](const cluon::MetaMessage &_mm){ trans.visit(_mm); });
                 content = transformation.content();
             }
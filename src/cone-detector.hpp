@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONE_DETECTOR_HPP
+#define CONE_DETECTOR_HPP
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+typedef struct
+{
+    double x;
+    double y;
+} COORDINATE;
+
+// Minimum number of pixels of one colour to consider having identified at least one cone
+const int min_pixels = 55;
+
+// Blue
+const int blue_low_H = 108, blue_low_S = 95, blue_low_V = 50;
+const int blue_high_H = 146, blue_high_S = 178, blue_high_V = 88;
+
+// Yellow
+const int yellow_low_H = 0, yellow_low_S = 83, yellow_low_V = 112;
+const int yellow_high_H = 98, yellow_high_S = 193, yellow_high_V = 225;
+
+/**
+ * @return Mean position of the pixels set in the given thresholded image, or (0, 0) if there are too few.
+ */
+inline COORDINATE meanCoOrdinate(const cv::Mat &colour_threshold)
+{
+    COORDINATE pos{0, 0};
+
+    //Calculate the moments of the thresholded image
+    cv::Moments oMoments = cv::moments(colour_threshold);
+
+    double dM01 = oMoments.m01;
+    double dM10 = oMoments.m10;
+    double dArea = oMoments.m00;
+
+    // if the area <= min_pixels, I consider that the there are no object in the image and it's because of the noise, the area is not zero
+    if (dArea > min_pixels)
+    {
+        //calculate the position of the cones
+        pos.x = dM10 / dArea;
+        pos.y = dM01 / dArea;
+    }
+
+    return pos;
+}
+
+/**
+ * The vision kernels of the detector, one method per stage. The intermediate
+ * images are kept as members so that they are re-used from frame to frame.
+ * main.cpp and the benchmarks both run this class to measure the same code.
+ */
+class ConeDetector
+{
+public:
+    /**
+     * @param offset_x Columns to cut away on the left.
+     * @param offset_y Rows to cut away on top (the 'sky').
+     */
+    explicit ConeDetector(int offset_x = 30, int offset_y = 267)
+        : m_offsetX(offset_x), m_offsetY(offset_y), m_kernel(cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(5, 5)))
+    {
+    }
+
+public:
+    /**
+     * Crop the image to ignore the 'sky' and draw a black circle over the car's cables.
+     *
+     * @param img Image to crop; it is modified as the returned view shares its pixels.
+     * @return View into img with the region of interest.
+     */
+    inline cv::Mat crop(cv::Mat &img)
+    {
+        cv::Rect roi;
+        roi.x = m_offsetX;
+        roi.y = m_offsetY;
+        roi.width = img.size().width - (m_offsetX);
+        roi.height = img.size().height - (m_offsetY);
+
+        cv::Mat crop = img(roi);
+
+        // Drawing a black circle over the car's cables (So that we do not see them)
+        cv::circle(crop, cv::Point(crop.cols / 2, ((crop.rows / 3) * 2) + 60), 100, cv::Scalar(0, 0, 0), CV_FILLED, 8, 0);
+        return crop;
+    }
+
+    // Convert from BGR to HSV colourspace
+    inline void convert(const cv::Mat &crop)
+    {
+        cv::cvtColor(crop, m_frameHSV, cv::COLOR_BGR2HSV);
+    }
+
+    // Detect the cones based on HSV Range Values
+    inline void threshold()
+    {
+        cv::inRange(m_frameHSV, cv::Scalar(yellow_low_H, yellow_low_S, yellow_low_V), cv::Scalar(yellow_high_H, yellow_high_S, yellow_high_V), m_yellowThreshold);
+        cv::inRange(m_frameHSV, cv::Scalar(blue_low_H, blue_low_S, blue_low_V), cv::Scalar(blue_high_H, blue_high_S, blue_high_V), m_blueThreshold);
+    }
+
+    // Morphological closing (removes small holes from the foreground)
+    inline void close()
+    {
+        cv::dilate(m_yellowThreshold, m_yellowThreshold, m_kernel);
+        cv::erode(m_yellowThreshold, m_yellowThreshold, m_kernel);
+
+        cv::dilate(m_blueThreshold, m_blueThreshold, m_kernel);
+        cv::erode(m_blueThreshold, m_blueThreshold, m_kernel);
+    }
+
+    // Count the pixels of each colour and decide whether any cones are visible
+    inline void count()
+    {
+        m_yellowPixels = cv::countNonZero(m_yellowThreshold);
+        m_bluePixels = cv::countNonZero(m_blueThreshold);
+    }
+
+    // Locate the mean position of each visible cone colour; -1 if not visible
+    inline void locate()
+    {
+        m_yellowMean = yellowDetected() ? meanCoOrdinate(m_yellowThreshold) : COORDINATE{-1, -1};
+        m_blueMean = blueDetected() ? meanCoOrdinate(m_blueThreshold) : COORDINATE{-1, -1};
+    }
+
+    /**
+     * Run all stages on the given image.
+     *
+     * @param img Image to process; it is modified by crop().
+     */
+    inline void detect(cv::Mat &img)
+    {
+        convert(crop(img));
+        threshold();
+        close();
+        count();
+        locate();
+    }
+
+public:
+    inline cv::Mat &frameHSV() noexcept { return m_frameHSV; }
+    inline cv::Mat &yellowThreshold() noexcept { return m_yellowThreshold; }
+    inline cv::Mat &blueThreshold() noexcept { return m_blueThreshold; }
+    inline int yellowPixels() const noexcept { return m_yellowPixels; }
+    inline int bluePixels() const noexcept { return m_bluePixels; }
+    inline bool yellowDetected() const noexcept { return m_yellowPixels > min_pixels; }
+    inline bool blueDetected() const noexcept { return m_bluePixels > min_pixels; }
+    inline const COORDINATE &yellowMean() const noexcept { return m_yellowMean; }
+    inline const COORDINATE &blueMean() const noexcept { return m_blueMean; }
+
+private:
+    int m_offsetX;
+    int m_offsetY;
+    cv::Mat m_kernel;
+
+    cv::Mat m_frameHSV{};
+    cv::Mat m_yellowThreshold{};
+    cv::Mat m_blueThreshold{};
+
+    int m_yellowPixels{-1};
+    int m_bluePixels{-1};
+    COORDINATE m_yellowMean{-1, -1};
+    COORDINATE m_blueMean{-1, -1};
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_LATENCY_HPP
+#define FRAME_LATENCY_HPP
+
+#include "latency-histogram.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+/**
+ * Glass-to-decision latency: the age of a frame (time since the producer's
+ * sample time stamp) when the steering verdict is decided and when it is
+ * published. Both time stamps are expected in microseconds since epoch.
+ */
+class FrameLatency
+{
+public:
+    /**
+     * @param deadline Maximum allowed frame age at publish time in microseconds.
+     */
+    explicit FrameLatency(int64_t deadline) noexcept
+        : m_deadline(deadline)
+    {
+    }
+
+public:
+    inline void atDecision(int64_t sampleTimeStamp, int64_t now) noexcept
+    {
+        if (isValid(sampleTimeStamp, now))
+        {
+            m_ageAtDecision.record(static_cast<uint64_t>(now - sampleTimeStamp) * 1000);
+        }
+    }
+
+    /**
+     * @return true if the frame missed the deadline.
+     */
+    inline bool atPublish(int64_t sampleTimeStamp, int64_t now) noexcept
+    {
+        bool missed = false;
+        ++m_frames;
+        if (isValid(sampleTimeStamp, now))
+        {
+            m_ageAtPublish.record(static_cast<uint64_t>(now - sampleTimeStamp) * 1000);
+            missed = (now - sampleTimeStamp) > m_deadline;
+            m_missedDeadlines += missed ? 1 : 0;
+        }
+        else
+        {
+            // Missing or future sample time stamps (e.g. clock skew) cannot be judged
+            ++m_invalidTimeStamps;
+        }
+        return missed;
+    }
+
+    inline uint64_t frames() const noexcept { return m_frames; }
+    inline uint64_t missedDeadlines() const noexcept { return m_missedDeadlines; }
+    inline uint64_t invalidTimeStamps() const noexcept { return m_invalidTimeStamps; }
+    inline int64_t deadline() const noexcept { return m_deadline; }
+    inline const LatencyHistogram &ageAtDecision() const noexcept { return m_ageAtDecision; }
+    inline const LatencyHistogram &ageAtPublish() const noexcept { return m_ageAtPublish; }
+
+    /**
+     * Print a human-readable summary in milliseconds.
+     */
+    inline void printSummary(std::ostream &out) const
+    {
+        out << "Frame age after " << m_frames << " frames [ms]:" << std::endl;
+        print(out, "at decision", m_ageAtDecision);
+        print(out, "at publish", m_ageAtPublish);
+        out << "Missed deadline (" << m_deadline / 1000.0 << " ms): " << m_missedDeadlines
+            << ", invalid sample time stamps: " << m_invalidTimeStamps << std::endl;
+    }
+
+    /**
+     * Append both histograms to the given CSV file; values are given in nanoseconds.
+     */
+    inline void writeCsv(const std::string &fileName, int64_t timeStamp) const
+    {
+        std::ifstream existing(fileName);
+        const bool writeHeader = !existing.good();
+        existing.close();
+
+        std::ofstream file(fileName, std::ios::app);
+        if (writeHeader)
+        {
+            file << "time_stamp,measurement,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,deadline_us,missed_deadlines\n";
+        }
+        writeCsvLine(file, timeStamp, "age_at_decision", m_ageAtDecision);
+        writeCsvLine(file, timeStamp, "age_at_publish", m_ageAtPublish);
+    }
+
+private:
+    static inline bool isValid(int64_t sampleTimeStamp, int64_t now) noexcept
+    {
+        return (0 < sampleTimeStamp) && (sampleTimeStamp <= now);
+    }
+
+    static inline void print(std::ostream &out, const char *label, const LatencyHistogram &h)
+    {
+        out << std::setw(12) << std::left << label << std::right << std::fixed << std::setprecision(2)
+            << " p50 " << h.percentile(50) / 1e6 << " p90 " << h.percentile(90) / 1e6 << " p99 " << h.percentile(99) / 1e6
+            << " p99.9 " << h.percentile(99.9) / 1e6 << " max " << h.max() / 1e6 << std::endl;
+    }
+
+    inline void writeCsvLine(std::ostream &out, int64_t timeStamp, const char *label, const LatencyHistogram &h) const
+    {
+        out << timeStamp << "," << label << "," << h.count() << "," << h.mean() << "," << h.percentile(50) << ","
+            << h.percentile(90) << "," << h.percentile(99) << "," << h.percentile(99.9) << "," << h.max() << ","
+            << m_deadline << "," << m_missedDeadlines << "\n";
+    }
+
+private:
+    int64_t m_deadline;
+    LatencyHistogram m_ageAtDecision{};
+    LatencyHistogram m_ageAtPublish{};
+    uint64_t m_frames{0};
+    uint64_t m_missedDeadlines{0};
+    uint64_t m_invalidTimeStamps{0};
+};
+
+#endif
@@ -0,0 +1,462 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Replays frames into a shared memory area like the camera microservice does
+// and collects the detector's output to report end-to-end performance.
+
+#include "cluon-complete.hpp"
+#include "latency-histogram.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * A source of BGRA frames with the size of the shared memory area.
+ */
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+    virtual bool next(cv::Mat &frame) = 0;
+    virtual void rewind() = 0;
+};
+
+// Frames from the image files in a directory in alphabetical order
+class ImageDirectorySource : public FrameSource
+{
+public:
+    ImageDirectorySource(const std::string &directory, cv::Size size)
+        : m_files(), m_size(size)
+    {
+        for (const char *pattern : {"/*.png", "/*.jpg", "/*.jpeg", "/*.bmp"})
+        {
+            std::vector<cv::String> files;
+            cv::glob(directory + pattern, files, false);
+            m_files.insert(m_files.end(), files.begin(), files.end());
+        }
+        std::sort(m_files.begin(), m_files.end());
+    }
+
+    bool next(cv::Mat &frame) override
+    {
+        if (m_next >= m_files.size())
+        {
+            return false;
+        }
+        return toBGRA(cv::imread(m_files[m_next++], cv::IMREAD_COLOR), m_size, frame);
+    }
+
+    void rewind() override { m_next = 0; }
+
+    static bool toBGRA(const cv::Mat &image, cv::Size size, cv::Mat &frame)
+    {
+        if (image.empty())
+        {
+            return false;
+        }
+        cv::Mat resized;
+        if ((image.cols != size.width) || (image.rows != size.height))
+        {
+            cv::resize(image, resized, size);
+        }
+        else
+        {
+            resized = image;
+        }
+        cv::cvtColor(resized, frame, cv::COLOR_BGR2BGRA);
+        return true;
+    }
+
+private:
+    std::vector<cv::String> m_files;
+    cv::Size m_size;
+    std::size_t m_next{0};
+};
+
+// Frames from a raw dump of consecutive BGRA frames, i.e., copies of the shared memory
+class RawDumpSource : public FrameSource
+{
+public:
+    RawDumpSource(const std::string &file, cv::Size size)
+        : m_file(file, std::ios::binary), m_size(size)
+    {
+    }
+
+    bool next(cv::Mat &frame) override
+    {
+        frame.create(m_size, CV_8UC4);
+        m_file.read(reinterpret_cast<char *>(frame.data), static_cast<std::streamsize>(frame.total() * frame.elemSize()));
+        return m_file.good();
+    }
+
+    void rewind() override
+    {
+        m_file.clear();
+        m_file.seekg(0);
+    }
+
+private:
+    std::ifstream m_file;
+    cv::Size m_size;
+};
+
+// Frames from a video file
+class VideoSource : public FrameSource
+{
+public:
+    VideoSource(const std::string &file, cv::Size size)
+        : m_file(file), m_capture(file), m_size(size)
+    {
+    }
+
+    bool next(cv::Mat &frame) override
+    {
+        cv::Mat image;
+        return m_capture.read(image) && ImageDirectorySource::toBGRA(image, m_size, frame);
+    }
+
+    void rewind() override { m_capture = cv::VideoCapture(m_file); }
+
+private:
+    std::string m_file;
+    cv::VideoCapture m_capture;
+    cv::Size m_size;
+};
+
+// All frames of another source held in memory to not disturb the timing with I/O or decoding
+class PreloadedSource : public FrameSource
+{
+public:
+    explicit PreloadedSource(FrameSource &source)
+        : m_frames()
+    {
+        cv::Mat frame;
+        while (source.next(frame))
+        {
+            m_frames.push_back(frame.clone());
+        }
+    }
+
+    bool next(cv::Mat &frame) override
+    {
+        if (m_next >= m_frames.size())
+        {
+            return false;
+        }
+        frame = m_frames[m_next++];
+        return true;
+    }
+
+    void rewind() override { m_next = 0; }
+
+private:
+    std::vector<cv::Mat> m_frames;
+    std::size_t m_next{0};
+};
+
+/**
+ * Reads the detector's output lines (group_17;<sample time stamp>;<verdict>)
+ * and matches them with the frames that have been sent.
+ */
+class OutputCollector
+{
+public:
+    explicit OutputCollector(const std::string &fileName)
+        : m_fileName(fileName)
+    {
+    }
+
+    ~OutputCollector() { stop(); }
+
+    // Blocks until the detector has opened its end of the FIFO.
+    bool start()
+    {
+        m_fd = ::open(m_fileName.c_str(), O_RDONLY);
+        if (0 > m_fd)
+        {
+            return false;
+        }
+        m_running.store(true);
+        m_thread = std::thread(&OutputCollector::collect, this);
+        return true;
+    }
+
+    void stop()
+    {
+        m_running.store(false);
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+        if (!(0 > m_fd))
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    void sent(int64_t sampleTimeStamp)
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_outstanding.insert(sampleTimeStamp);
+    }
+
+    void report(std::ostream &out, uint64_t framesSent, double seconds)
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        const uint64_t dropped = framesSent - m_matched;
+        out << "Detector outputs: " << m_matched << " (" << m_unmatched << " unmatched lines)" << std::endl;
+        out << "Sustained FPS:    " << std::fixed << std::setprecision(2) << ((seconds > 0) ? m_matched / seconds : 0) << std::endl;
+        out << "Dropped frames:   " << dropped << " (" << ((framesSent > 0) ? 100.0 * dropped / framesSent : 0) << "%)" << std::endl;
+        out << "Latency [ms]:     p50 " << m_latency.percentile(50) / 1e6 << " p90 " << m_latency.percentile(90) / 1e6 << " p99 "
+            << m_latency.percentile(99) / 1e6 << " p99.9 " << m_latency.percentile(99.9) / 1e6 << " max " << m_latency.max() / 1e6 << std::endl;
+    }
+
+private:
+    void collect()
+    {
+        std::string pending;
+        std::vector<char> buffer(4096);
+        while (m_running.load())
+        {
+            struct pollfd fds
+            {
+                m_fd, POLLIN, 0
+            };
+            if (0 >= ::poll(&fds, 1, 100))
+            {
+                continue;
+            }
+            const ssize_t bytesRead = ::read(m_fd, buffer.data(), buffer.size());
+            if (0 >= bytesRead)
+            {
+                // The detector has closed its end.
+                break;
+            }
+            const int64_t now = cluon::time::toMicroseconds(cluon::time::now());
+            pending.append(buffer.data(), static_cast<std::size_t>(bytesRead));
+
+            std::size_t pos;
+            while (std::string::npos != (pos = pending.find('\n')))
+            {
+                match(pending.substr(0, pos), now);
+                pending.erase(0, pos + 1);
+            }
+        }
+    }
+
+    void match(const std::string &line, int64_t now)
+    {
+        const std::size_t first = line.find(';');
+        const std::size_t second = line.find(';', first + 1);
+        if ((std::string::npos == first) || (std::string::npos == second))
+        {
+            return;
+        }
+        const int64_t sampleTimeStamp = std::stoll(line.substr(first + 1, second - first - 1));
+
+        std::lock_guard<std::mutex> lck(m_mutex);
+        auto it = m_outstanding.find(sampleTimeStamp);
+        if (it != m_outstanding.end())
+        {
+            m_outstanding.erase(it);
+            ++m_matched;
+            m_latency.record(static_cast<uint64_t>(std::max<int64_t>(0, now - sampleTimeStamp)) * 1000);
+        }
+        else
+        {
+            ++m_unmatched;
+        }
+    }
+
+private:
+    std::string m_fileName;
+    int m_fd{-1};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread{};
+
+    std::mutex m_mutex{};
+    std::unordered_set<int64_t> m_outstanding{};
+    uint64_t m_matched{0};
+    uint64_t m_unmatched{0};
+    LatencyHistogram m_latency{};
+};
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    const bool hasSource = (0 != commandlineArguments.count("images")) || (0 != commandlineArguments.count("raw")) || (0 != commandlineArguments.count("video"));
+    if ((0 == commandlineArguments.count("name")) ||
+        (0 == commandlineArguments.count("width")) ||
+        (0 == commandlineArguments.count("height")) ||
+        !hasSource)
+    {
+        std::cerr << argv[0] << " creates a shared memory area and replays ARGB frames into it." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --name=<name of shared memory area> --width=<w> --height=<h> (--images=<dir> | --raw=<file> | --video=<file>) [--fps=<n>] [--frames=<n>] [--loop] [--preload] [--detector-output=<fifo>] [--delay=<ms>] [--linger=<ms>]" << std::endl;
+        std::cerr << "         --name:            name of the shared memory area to create" << std::endl;
+        std::cerr << "         --width:           width of the frame" << std::endl;
+        std::cerr << "         --height:          height of the frame" << std::endl;
+        std::cerr << "         --images:          directory with .png/.jpg/.bmp files replayed in alphabetical order" << std::endl;
+        std::cerr << "         --raw:             file with consecutive raw BGRA frames" << std::endl;
+        std::cerr << "         --video:           video file" << std::endl;
+        std::cerr << "         --fps:             frames per second; 0 = unthrottled (default: 30)" << std::endl;
+        std::cerr << "         --frames:          stop after n frames (default: all)" << std::endl;
+        std::cerr << "         --loop:            rewind the source when it is exhausted" << std::endl;
+        std::cerr << "         --preload:         decode all frames before replaying them" << std::endl;
+        std::cerr << "         --detector-output: FIFO (created if missing) the detector's stdout is redirected to" << std::endl;
+        std::cerr << "         --delay:           time to wait for the detector to attach before replaying (default: 1000)" << std::endl;
+        std::cerr << "         --linger:          time to wait for outstanding detector outputs at the end (default: 1000)" << std::endl;
+        std::cerr << "Example: mkfifo out; " << argv[0] << " --name=img --width=640 --height=480 --images=frames --fps=0 --detector-output=out &" << std::endl;
+        std::cerr << "         ./Group17-Steering-Wheel-Angle --cid=253 --name=img --width=640 --height=480 > out" << std::endl;
+    }
+    else
+    {
+        const std::string NAME{commandlineArguments["name"]};
+        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
+        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const double FPS{(commandlineArguments.count("fps") != 0) ? std::stod(commandlineArguments["fps"]) : 30.0};
+        const uint64_t FRAMES{(commandlineArguments.count("frames") != 0) ? static_cast<uint64_t>(std::stoll(commandlineArguments["frames"])) : 0};
+        const bool LOOP{commandlineArguments.count("loop") != 0};
+        const std::string DETECTOR_OUTPUT{(commandlineArguments.count("detector-output") != 0) ? commandlineArguments["detector-output"] : ""};
+        const int32_t DELAY{(commandlineArguments.count("delay") != 0) ? std::stoi(commandlineArguments["delay"]) : 1000};
+        const int32_t LINGER{(commandlineArguments.count("linger") != 0) ? std::stoi(commandlineArguments["linger"]) : 1000};
+        const cv::Size SIZE(static_cast<int>(WIDTH), static_cast<int>(HEIGHT));
+
+        std::unique_ptr<FrameSource> source;
+        if (0 != commandlineArguments.count("images"))
+        {
+            source.reset(new ImageDirectorySource(commandlineArguments["images"], SIZE));
+        }
+        else if (0 != commandlineArguments.count("raw"))
+        {
+            source.reset(new RawDumpSource(commandlineArguments["raw"], SIZE));
+        }
+        else
+        {
+            source.reset(new VideoSource(commandlineArguments["video"], SIZE));
+        }
+        if (0 != commandlineArguments.count("preload"))
+        {
+            source.reset(new PreloadedSource(*source));
+        }
+
+        std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME, WIDTH * HEIGHT * 4}};
+        if (sharedMemory && sharedMemory->valid())
+        {
+            std::clog << argv[0] << ": Created shared memory '" << sharedMemory->name() << "' (" << sharedMemory->size() << " bytes)." << std::endl;
+
+            std::unique_ptr<OutputCollector> collector;
+            if (!DETECTOR_OUTPUT.empty())
+            {
+                struct stat fileStatus;
+                if ((0 != ::stat(DETECTOR_OUTPUT.c_str(), &fileStatus)) && (0 != ::mkfifo(DETECTOR_OUTPUT.c_str(), 0600)))
+                {
+                    std::cerr << argv[0] << ": Failed to create FIFO '" << DETECTOR_OUTPUT << "': " << ::strerror(errno) << std::endl;
+                    return retCode;
+                }
+                std::clog << argv[0] << ": Waiting for the detector to write to '" << DETECTOR_OUTPUT << "'." << std::endl;
+                collector.reset(new OutputCollector(DETECTOR_OUTPUT));
+                if (!collector->start())
+                {
+                    std::cerr << argv[0] << ": Failed to open '" << DETECTOR_OUTPUT << "': " << ::strerror(errno) << std::endl;
+                    return retCode;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(DELAY));
+
+            const auto PERIOD = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>((FPS > 0) ? 1.0 / FPS : 0.0));
+            const auto start = std::chrono::steady_clock::now();
+            auto nextFrame = start;
+            uint64_t framesSent{0};
+
+            cv::Mat frame;
+            while ((0 == FRAMES) || (framesSent < FRAMES))
+            {
+                if (!source->next(frame))
+                {
+                    if (!LOOP)
+                    {
+                        break;
+                    }
+                    source->rewind();
+                    if (!source->next(frame))
+                    {
+                        break;
+                    }
+                }
+
+                if (FPS > 0)
+                {
+                    std::this_thread::sleep_until(nextFrame);
+                    nextFrame += PERIOD;
+                }
+
+                const cluon::data::TimeStamp sampleTimeStamp{cluon::time::now()};
+                if (collector)
+                {
+                    collector->sent(cluon::time::toMicroseconds(sampleTimeStamp));
+                }
+
+                sharedMemory->lock();
+                std::memcpy(sharedMemory->data(), frame.data, std::min<std::size_t>(sharedMemory->size(), frame.total() * frame.elemSize()));
+                sharedMemory->setTimeStamp(sampleTimeStamp);
+                sharedMemory->unlock();
+                sharedMemory->notifyAll();
+                ++framesSent;
+            }
+            const double SECONDS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << "Frames sent:      " << framesSent << " in " << std::fixed << std::setprecision(2) << SECONDS << " s ("
+                      << ((SECONDS > 0) ? framesSent / SECONDS : 0) << " FPS)" << std::endl;
+            if (collector)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(LINGER));
+                collector->stop();
+                collector->report(std::cout, framesSent, SECONDS);
+            }
+            retCode = 0;
+        }
+        else
+        {
+            std::cerr << argv[0] << ": Failed to create shared memory '" << NAME << "'." << std::endl;
+        }
+    }
+    return retCode;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Log-linear histogram for latencies given in nanoseconds.
+ *
+ * Values are grouped by their power of two and every power of two is split
+ * into SUB_BUCKETS linear buckets; hence, the relative error of a reported
+ * percentile is bounded by 1/SUB_BUCKETS while recording a value is just a
+ * few bit operations and one increment (no allocation, no locking).
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 5;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+public:
+    inline void record(uint64_t value) noexcept
+    {
+        ++m_buckets[indexOf(value)];
+        ++m_count;
+        m_sum += value;
+        m_min = (value < m_min) ? value : m_min;
+        m_max = (value > m_max) ? value : m_max;
+    }
+
+    inline void merge(const LatencyHistogram &other) noexcept
+    {
+        for (uint32_t i = 0; i < BUCKETS; i++)
+        {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = (other.m_min < m_min) ? other.m_min : m_min;
+        m_max = (other.m_max > m_max) ? other.m_max : m_max;
+    }
+
+    inline void reset() noexcept
+    {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_sum = 0;
+        m_min = std::numeric_limits<uint64_t>::max();
+        m_max = 0;
+    }
+
+    /**
+     * @param p Percentile in the range [0, 100].
+     * @return Upper bound of the bucket holding the given percentile (never larger than max()).
+     */
+    inline uint64_t percentile(double p) const noexcept
+    {
+        if (0 == m_count)
+        {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>((p / 100.0) * static_cast<double>(m_count) + 0.5);
+        rank = (rank < 1) ? 1 : ((rank > m_count) ? m_count : rank);
+
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++)
+        {
+            seen += m_buckets[i];
+            if (seen >= rank)
+            {
+                const uint64_t upper = upperBoundOf(i);
+                return (upper > m_max) ? m_max : upper;
+            }
+        }
+        return m_max;
+    }
+
+    inline uint64_t count() const noexcept { return m_count; }
+    inline uint64_t min() const noexcept { return (0 == m_count) ? 0 : m_min; }
+    inline uint64_t max() const noexcept { return m_max; }
+    inline uint64_t mean() const noexcept { return (0 == m_count) ? 0 : m_sum / m_count; }
+
+private:
+    static inline uint32_t indexOf(uint64_t value) noexcept
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return static_cast<uint32_t>(value);
+        }
+        const uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+        const uint32_t shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS + static_cast<uint32_t>((value >> shift) - SUB_BUCKETS);
+    }
+
+    static inline uint64_t upperBoundOf(uint32_t index) noexcept
+    {
+        if (index < 2 * SUB_BUCKETS)
+        {
+            return index;
+        }
+        const uint32_t shift = index / SUB_BUCKETS - 1;
+        const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+        return lower + ((static_cast<uint64_t>(1) << shift) - 1);
+    }
+
+private:
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count{0};
+    uint64_t m_sum{0};
+    uint64_t m_min{std::numeric_limits<uint64_t>::max()};
+    uint64_t m_max{0};
+};
+
+#endif
@@ -19,6 +19,12 @@
 #include "cluon-complete.hpp"
 // Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
 #include "opendlv-standard-message-set.hpp"
+// Include the per-stage latency histograms (compiled out unless ENABLE_STAGE_TIMING is set)
+#include "stage-timing.hpp"
+// Include the glass-to-decision latency measurement
+#include "frame-latency.hpp"
+// Include the vision kernels shared with the benchmarks
+#include "cone-detector.hpp"
 
 // Include the GUI and image processing header files from OpenCV
 #include <opencv2/highgui/highgui.hpp>
@@ -28,32 +34,22 @@
 #include "opencv2/highgui.hpp"
 #include "opencv2/videoio.hpp"
 
+#include <atomic>
+#include <csignal>
 #include <ctime>
 #include <iostream>
 #include <fstream>
+#include <thread>
+
+#include <pthread.h>
 
 using namespace cv;
 using namespace std;
 
-typedef struct
-{
-    double x;
-    double y;
-} COORDINATE;
-
 const int max_value_H = 360 / 2;
 const int max_value = 255;
 const String window_capture_name = "Image Capture";
 const String window_detection_name = "Object Detection";
-const int min_pixels = 55;
-
-// Blue
-int blue_low_H = 108, blue_low_S = 95, blue_low_V = 50;
-int blue_high_H = 146, blue_high_S = 178, blue_high_V = 88;
-
-// Yellow
-int yellow_low_H = 0, yellow_low_S = 83, yellow_low_V = 112;
-int yellow_high_H = 98, yellow_high_S = 193, yellow_high_V = 225;
 
 // Default
 int low_H = 0, low_S = 0, low_V = 0;
@@ -64,31 +60,6 @@ inline int64_t toMicroseconds(const cluon::data::TimeStamp &tp) noexcept
     return static_cast<int64_t>(tp.seconds()) * static_cast<int64_t>(1000 * 1000) + static_cast<int64_t>(tp.microseconds());
 }
 
-COORDINATE *meanCoOrdinate(Mat colour_threshold)
-{
-    COORDINATE *pos;
-    pos = (COORDINATE *)malloc(sizeof(COORDINATE));
-    pos->x = 0;
-    pos->y = 0;
-
-    //Calculate the moments of the thresholded image
-    Moments oMoments = moments(colour_threshold);
-
-    double dM01 = oMoments.m01;
-    double dM10 = oMoments.m10;
-    double dArea = oMoments.m00;
-
-    // if the area <= 1000, I consider that the there are no object in the image and it's because of the noise, the area is not zero
-    if (dArea > min_pixels)
-    {
-        //calculate the position of the cones
-        pos->x = dM10 / dArea;
-        pos->y = dM01 / dArea;
-    }
-
-    return pos;
-}
-
 int32_t main(int32_t argc, char **argv)
 {
 
@@ -106,6 +77,15 @@ int32_t main(int32_t argc, char **argv)
         std::cerr << "         --name:   name of the shared memory area to attach" << std::endl;
         std::cerr << "         --width:  width of the frame" << std::endl;
         std::cerr << "         --height: height of the frame" << std::endl;
+        std::cerr << "         --deadline:         maximum frame age in ms when the verdict is published (default: 50)" << std::endl;
+        std::cerr << "         --latency-file:     CSV file to append the frame age histograms to (default: none)" << std::endl;
+        std::cerr << "         --latency-interval: write the frame age histograms every n frames (default: 1000)" << std::endl;
+#ifdef ENABLE_STAGE_TIMING
+        std::cerr << "         --timing-file:     CSV file to append the per-stage latency histograms to (default: timing.csv)" << std::endl;
+        std::cerr << "         --timing-interval: dump the per-stage latency histograms every n frames; 0 = only on SIGUSR1 and exit (default: 1000)" << std::endl;
+        std::cerr << "         --trace:           Chrome trace JSON file to write the spans of all stages and of libcluon to on SIGUSR1 and exit (default: none)" << std::endl;
+        std::cerr << "         --trace-events:    maximum number of spans recorded per thread (default: 262144)" << std::endl;
+#endif
         std::cerr << "Example: " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --verbose" << std::endl;
     }
     else
@@ -115,6 +95,33 @@ int32_t main(int32_t argc, char **argv)
         const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
         const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
         const bool VERBOSE{commandlineArguments.count("verbose") != 0};
+        const int64_t DEADLINE{static_cast<int64_t>((commandlineArguments.count("deadline") != 0) ? std::stod(commandlineArguments["deadline"]) * 1000 : 50 * 1000)};
+        const std::string LATENCY_FILE{(commandlineArguments.count("latency-file") != 0) ? commandlineArguments["latency-file"] : ""};
+        const uint64_t LATENCY_INTERVAL{(commandlineArguments.count("latency-interval") != 0) ? static_cast<uint64_t>(std::stoi(commandlineArguments["latency-interval"])) : 1000};
+#ifdef ENABLE_STAGE_TIMING
+        const std::string TIMING_FILE{(commandlineArguments.count("timing-file") != 0) ? commandlineArguments["timing-file"] : "timing.csv"};
+        const uint64_t TIMING_INTERVAL{(commandlineArguments.count("timing-interval") != 0) ? static_cast<uint64_t>(std::stoi(commandlineArguments["timing-interval"])) : 1000};
+
+        // Per-stage latency histograms; SIGUSR1 requests an immediate dump
+        StageTimings stageTimings;
+        std::signal(SIGUSR1, onStageTimingsDumpSignal);
+
+        // Spans for outlier frames, viewable in chrome://tracing or ui.perfetto.dev
+        const std::string TRACE_FILE{(commandlineArguments.count("trace") != 0) ? commandlineArguments["trace"] : ""};
+        if (!TRACE_FILE.empty())
+        {
+            cluon::Tracer::instance().setThreadName("frame loop");
+            cluon::Tracer::instance().enable((commandlineArguments.count("trace-events") != 0) ? static_cast<uint32_t>(std::stoi(commandlineArguments["trace-events"])) : 262144);
+        }
+#endif
+
+        // SIGINT and SIGTERM are taken by a dedicated thread further below instead of a signal handler, so that it
+        // can also wake up the frame loop; block them before the first thread is started so that all threads inherit it.
+        sigset_t terminationSignals;
+        sigemptyset(&terminationSignals);
+        sigaddset(&terminationSignals, SIGINT);
+        sigaddset(&terminationSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &terminationSignals, nullptr);
 
         // Attach to the shared memory.
         std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME}};
@@ -126,17 +133,9 @@ int32_t main(int32_t argc, char **argv)
             // The instance od4 allows you to send and receive messages.
             cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))};
 
-            opendlv::proxy::GroundSteeringRequest gsr;
-            std::mutex gsrMutex;
-            auto onGroundSteeringRequest = [&gsr, &gsrMutex](cluon::data::Envelope &&env) {
-                // The envelope data structure provide further details, such as sampleTimePoint as shown in this test case:
-                // https://github.com/chrberger/libcluon/blob/master/libcluon/testsuites/TestEnvelopeConverter.cpp#L31-L40
-                std::lock_guard<std::mutex> lck(gsrMutex);
-                gsr = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env));
-                // std::cout << "lambda: groundSteering = " << gsr.groundSteering() << std::endl;
-            };
-
-            od4.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequest);
+            // The latest received ground steering request; the frame loop samples it without locking.
+            cluon::LatestValue<opendlv::proxy::GroundSteeringRequest> gsr;
+            od4.keepLatest(gsr);
 
             std::ofstream info_file;
             std::string info_file_name = "info.csv";
@@ -166,11 +165,16 @@ int32_t main(int32_t argc, char **argv)
                 info_file.close();
             }
 
+            // Age of each frame when the verdict is decided and published
+            FrameLatency frameLatency{DEADLINE};
+
             // variables for verdict descision
             int is_final = 0;
 
-            // Variables in which decoded images can be stored
-            Mat frame_HSV, yellow_threshold, blue_threshold;
+            // The vision kernels and the images in which decoded frames are stored
+            ConeDetector detector;
+            Mat &yellow_threshold = detector.yellowThreshold();
+            Mat &blue_threshold = detector.blueThreshold();
 
             // Variables for the number of detected conne pixels
             int yellow_cones_detected = 0;
@@ -199,10 +203,6 @@ int32_t main(int32_t argc, char **argv)
             int left_yellow = -1;
             int left_blue = 1;
 
-            // Values for cropping of image
-            int offset_x = 30;
-            int offset_y = 267;
-
             int cross_size = 60;
             int white_cross_colour = 255;
 
@@ -240,6 +240,19 @@ int32_t main(int32_t argc, char **argv)
             // Debug variables
             // ------------------------------------------------------
 
+            // SIGINT and SIGTERM end the loop below only once it returns from waiting for the next frame; sleep
+            // until one of them arrives, raise libcluon's termination flag and wake the loop up once so that the
+            // histograms and summaries after the loop are written.
+            std::atomic<bool> frameLoopRunning{true};
+            std::thread waitForTermination([&sharedMemory, &frameLoopRunning, &terminationSignals]() {
+                int received{0};
+                if ((0 == sigwait(&terminationSignals, &received)) && frameLoopRunning.load())
+                {
+                    cluon::TerminateHandler::instance().isTerminated.store(true);
+                    sharedMemory->notifyAll();
+                }
+            });
+
             // Endless loop; end the program by pressing Ctrl-C.
             while (od4.isRunning())
             {
@@ -250,8 +263,16 @@ int32_t main(int32_t argc, char **argv)
                 // OpenCV data structure to hold an image.
                 cv::Mat img;
 
+                STAGE_TIMING_START(stageTimings);
+
                 // Wait for a notification of a new frame.
                 sharedMemory->wait();
+                if (!od4.isRunning())
+                {
+                    break;
+                }
+
+                STAGE_TIMING_LAP(stageTimings, Stage::WAIT);
 
                 // Lock the shared memory.
                 sharedMemory->lock();
@@ -264,73 +285,65 @@ int32_t main(int32_t argc, char **argv)
                 // time stamp
                 long int time_stamp = toMicroseconds(sharedMemory->getTimeStamp().second);
 
-                // If you want to access the latest received ground steering, don't forget to lock the mutex:
+                // The latest received ground steering, if any
                 actual_ground_steering = 0;
                 {
-                    std::lock_guard<std::mutex> lck(gsrMutex);
-                    actual_ground_steering = gsr.groundSteering();
+                    opendlv::proxy::GroundSteeringRequest request;
+                    if (gsr.load(request))
+                    {
+                        actual_ground_steering = request.groundSteering();
+                    }
                 }
 
                 sharedMemory->unlock();
 
-                // Crop the image to ignore the 'sky'
-                cv::Rect roi;
-                roi.x = offset_x;
-                roi.y = offset_y;
-                roi.width = img.size().width - (offset_x);
-                roi.height = img.size().height - (offset_y);
+                STAGE_TIMING_LAP(stageTimings, Stage::LOCK_AND_COPY);
 
-                cv::Mat crop = img(roi);
+                // Crop the image to ignore the 'sky' and the car's cables
+                cv::Mat crop = detector.crop(img);
 
-                // Drawing a black circle over the car's cables (So that we do not see them)
-                cv::circle(crop, cv::Point(crop.cols / 2, ((crop.rows / 3) * 2) + 60), 100, cv::Scalar(0, 0, 0), CV_FILLED, 8, 0);
+                STAGE_TIMING_LAP(stageTimings, Stage::CROP);
 
                 // Re-initialise variables to store pixels count
                 blue_pixels = -1;
                 yellow_pixels = -1;
 
                 // Convert from BGR to HSV colourspace
-                cv::cvtColor(crop, frame_HSV, COLOR_BGR2HSV);
+                detector.convert(crop);
 
-                // Detect the cones based on HSV Range Values
-                // Yellow
-                cv::inRange(frame_HSV, Scalar(yellow_low_H, yellow_low_S, yellow_low_V), Scalar(yellow_high_H, yellow_high_S, yellow_high_V), yellow_threshold);
+                STAGE_TIMING_LAP(stageTimings, Stage::CVT_COLOR);
 
-                // Blue
-                cv::inRange(frame_HSV, Scalar(blue_low_H, blue_low_S, blue_low_V), Scalar(blue_high_H, blue_high_S, blue_high_V), blue_threshold);
+                // Detect the yellow and blue cones based on HSV Range Values
+                detector.threshold();
 
-                //morphological closing (removes small holes from the foreground)
-                dilate(yellow_threshold, yellow_threshold, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
-                erode(yellow_threshold, yellow_threshold, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
+                STAGE_TIMING_LAP(stageTimings, Stage::IN_RANGE);
 
                 //morphological closing (removes small holes from the foreground)
-                dilate(blue_threshold, blue_threshold, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
-                erode(blue_threshold, blue_threshold, getStructuringElement(MORPH_ELLIPSE, Size(5, 5)));
+                detector.close();
 
-                // Counting yellow pixels
-                yellow_pixels = cv::countNonZero(yellow_threshold);
+                STAGE_TIMING_LAP(stageTimings, Stage::MORPHOLOGY);
 
-                // Counting blue pixels
-                blue_pixels = cv::countNonZero(blue_threshold);
+                // Counting yellow and blue pixels
+                detector.count();
+                yellow_pixels = detector.yellowPixels();
+                blue_pixels = detector.bluePixels();
+
+                STAGE_TIMING_LAP(stageTimings, Stage::COUNT_NON_ZERO);
 
                 // Determine if we have seen enough of each colour to consider having identified atleast one cone
-                yellow_cones_detected = yellow_pixels > min_pixels ? 1 : 0;
-                blue_cones_detected = blue_pixels > min_pixels ? 1 : 0;
+                yellow_cones_detected = detector.yellowDetected() ? 1 : 0;
+                blue_cones_detected = detector.blueDetected() ? 1 : 0;
 
-                // Re-initialise each cone co-ordinate
-                mean_yellow_x = -1;
-                mean_yellow_y = -1;
-                mean_blue_x = -1;
-                mean_blue_y = -1;
+                // Locate each cone colour (-1 if not detected)
+                detector.locate();
+                mean_yellow_x = detector.yellowMean().x;
+                mean_yellow_y = detector.yellowMean().y;
+                mean_blue_x = detector.blueMean().x;
+                mean_blue_y = detector.blueMean().y;
 
-                if (yellow_cones_detected)
-                {
-                    COORDINATE *mean_yellow = meanCoOrdinate(yellow_threshold);
-                    mean_yellow_x = mean_yellow->x;
-                    mean_yellow_y = mean_yellow->y;
-                    free(mean_yellow);
-                }
-                else if (blue_cones_detected)
+                STAGE_TIMING_LAP(stageTimings, Stage::MOMENTS);
+
+                if (!yellow_cones_detected && blue_cones_detected)
                 {
                     // We can see only blue cones, so we must turn away from them
                     // by default blue cones are on the left
@@ -338,14 +351,7 @@ int32_t main(int32_t argc, char **argv)
                     is_final = 1;
                 }
 
-                if (blue_cones_detected)
-                {
-                    COORDINATE *mean_blue = meanCoOrdinate(blue_threshold);
-                    mean_blue_x = mean_blue->x;
-                    mean_blue_y = mean_blue->y;
-                    free(mean_blue);
-                }
-                else if (yellow_cones_detected && !is_final)
+                if (!blue_cones_detected && yellow_cones_detected && !is_final)
                 {
                     // We can see yellow blue cones, so we must turn away from them
                     // by default blue cones are on the left
@@ -414,9 +420,25 @@ int32_t main(int32_t argc, char **argv)
                     }
                 }
 
+                STAGE_TIMING_LAP(stageTimings, Stage::DECISION);
+
+                frameLatency.atDecision(time_stamp, toMicroseconds(cluon::time::now()));
+
                 // Log the turn descision to console
                 std::cout << "group_17;" << time_stamp << ";" << steering_verdict << std::endl;
 
+                // Flag frames whose verdict was published too late
+                if (frameLatency.atPublish(time_stamp, toMicroseconds(cluon::time::now())))
+                {
+                    std::clog << argv[0] << ": Frame " << time_stamp << " missed the deadline of " << DEADLINE / 1000.0 << " ms." << std::endl;
+                }
+                if (!LATENCY_FILE.empty() && (0 < LATENCY_INTERVAL) && (0 == frameLatency.frames() % LATENCY_INTERVAL))
+                {
+                    frameLatency.writeCsv(LATENCY_FILE, time_stamp);
+                }
+
+                STAGE_TIMING_LAP(stageTimings, Stage::OUTPUT);
+
                 // Display debugging information if the VERBOSE flag was given
                 if (VERBOSE)
                 {
@@ -532,6 +554,49 @@ int32_t main(int32_t argc, char **argv)
                     cv::imshow("Debug Info", crop);
                     cv::waitKey(1);
                 }
+
+                STAGE_TIMING_LAP(stageTimings, Stage::DEBUG);
+                STAGE_TIMING_END_FRAME(stageTimings);
+
+#ifdef ENABLE_STAGE_TIMING
+                // Dump the histograms periodically or when requested via SIGUSR1
+                if (stageTimingsDumpRequested() || ((TIMING_INTERVAL > 0) && (0 == stageTimings.frames() % TIMING_INTERVAL)))
+                {
+                    dumpStageTimings(stageTimings, TIMING_FILE, time_stamp);
+                    if (stageTimingsDumpRequested() && !TRACE_FILE.empty())
+                    {
+                        cluon::Tracer::instance().writeChromeTrace(TRACE_FILE);
+                    }
+                    stageTimingsDumpRequested() = 0;
+                }
+#endif
+            }
+            // The loop can also end without a signal when od4 stops; release the waiting thread without a wake-up.
+            frameLoopRunning.store(false);
+            if (!cluon::TerminateHandler::instance().isTerminated.load())
+            {
+                pthread_kill(waitForTermination.native_handle(), SIGTERM);
+            }
+            waitForTermination.join();
+#ifdef ENABLE_STAGE_TIMING
+            dumpStageTimings(stageTimings, TIMING_FILE, cluon::time::toMicroseconds(cluon::time::now()));
+            if (!TRACE_FILE.empty())
+            {
+                cluon::Tracer::instance().disable();
+                if (!cluon::Tracer::instance().writeChromeTrace(TRACE_FILE))
+                {
+                    std::cerr << argv[0] << ": Failed to write trace to '" << TRACE_FILE << "'." << std::endl;
+                }
+                else if (0 < cluon::Tracer::instance().droppedEvents())
+                {
+                    std::clog << argv[0] << ": " << cluon::Tracer::instance().droppedEvents() << " spans were dropped; increase --trace-events." << std::endl;
+                }
+            }
+#endif
+            frameLatency.printSummary(std::clog);
+            if (!LATENCY_FILE.empty())
+            {
+                frameLatency.writeCsv(LATENCY_FILE, toMicroseconds(cluon::time::now()));
             }
         }
         retCode = 0;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STAGE_TIMING_HPP
+#define STAGE_TIMING_HPP
+
+#include "cluon-complete.hpp"
+#include "latency-histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string>
+
+// Stages of the detector pipeline in the order they are executed per frame.
+// FRAME is the sum of all stages except WAIT, i.e., the processing budget used.
+enum class Stage : uint8_t
+{
+    WAIT = 0,
+    LOCK_AND_COPY,
+    CROP,
+    CVT_COLOR,
+    IN_RANGE,
+    MORPHOLOGY,
+    COUNT_NON_ZERO,
+    MOMENTS,
+    DECISION,
+    OUTPUT,
+    DEBUG,
+    FRAME,
+    NUMBER_OF_STAGES
+};
+
+/**
+ * Per-stage latency histograms for the frame loop. Each stage is measured as
+ * the time since the previous lap, so a stage costs one steady_clock read.
+ * This class is meant to be used from the frame loop only (no locking).
+ * While cluon::Tracer is enabled, every lap is also recorded as a span.
+ */
+class StageTimings
+{
+public:
+    static constexpr std::size_t NUMBER_OF_STAGES = static_cast<std::size_t>(Stage::NUMBER_OF_STAGES);
+
+    static inline const char *name(Stage stage) noexcept
+    {
+        static const char *NAMES[NUMBER_OF_STAGES] = {
+            "wait", "lock_and_copy", "crop", "cvt_color", "in_range", "morphology",
+            "count_non_zero", "moments", "decision", "output", "debug", "frame"};
+        return NAMES[static_cast<std::size_t>(stage)];
+    }
+
+public:
+    inline void start() noexcept
+    {
+        m_last = std::chrono::steady_clock::now();
+        m_frameNanoseconds = 0;
+    }
+
+    inline void lap(Stage stage) noexcept
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const uint64_t delta = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last).count());
+        m_histograms[static_cast<std::size_t>(stage)].record(delta);
+        m_frameNanoseconds += (Stage::WAIT == stage) ? 0 : delta;
+        if (cluon::Tracer::instance().isEnabled())
+        {
+            cluon::Tracer::instance().record(name(stage), "pipeline", m_last, now);
+        }
+        m_frameBegin = (Stage::WAIT == stage) ? now : m_frameBegin;
+        m_last = now;
+    }
+
+    inline void endFrame() noexcept
+    {
+        m_histograms[static_cast<std::size_t>(Stage::FRAME)].record(m_frameNanoseconds);
+        if (cluon::Tracer::instance().isEnabled())
+        {
+            cluon::Tracer::instance().record(name(Stage::FRAME), "pipeline", m_frameBegin, m_last);
+        }
+        ++m_frames;
+    }
+
+    inline uint64_t frames() const noexcept { return m_frames; }
+
+    inline const LatencyHistogram &histogram(Stage stage) const noexcept
+    {
+        return m_histograms[static_cast<std::size_t>(stage)];
+    }
+
+    /**
+     * Print a human-readable table with all stages in microseconds.
+     */
+    inline void printSummary(std::ostream &out) const
+    {
+        out << "Stage timings after " << m_frames << " frames [us]:" << std::endl;
+        out << std::setw(16) << std::left << "stage" << std::right
+            << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+            << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+        for (std::size_t i = 0; i < NUMBER_OF_STAGES; i++)
+        {
+            const LatencyHistogram &h = m_histograms[i];
+            out << std::setw(16) << std::left << name(static_cast<Stage>(i)) << std::right << std::fixed << std::setprecision(1)
+                << std::setw(10) << h.percentile(50) / 1000.0 << std::setw(10) << h.percentile(90) / 1000.0
+                << std::setw(10) << h.percentile(99) / 1000.0 << std::setw(10) << h.percentile(99.9) / 1000.0
+                << std::setw(10) << h.max() / 1000.0 << std::endl;
+        }
+    }
+
+    /**
+     * Append one CSV line per stage; values are cumulative since start-up and given in nanoseconds.
+     *
+     * @param out Stream to write to.
+     * @param timeStamp Time stamp in microseconds to identify this dump.
+     */
+    inline void writeCsv(std::ostream &out, int64_t timeStamp) const
+    {
+        for (std::size_t i = 0; i < NUMBER_OF_STAGES; i++)
+        {
+            const LatencyHistogram &h = m_histograms[i];
+            out << timeStamp << "," << m_frames << "," << name(static_cast<Stage>(i)) << "," << h.count() << "," << h.mean()
+                << "," << h.percentile(50) << "," << h.percentile(90) << "," << h.percentile(99) << "," << h.percentile(99.9)
+                << "," << h.max() << "\n";
+        }
+    }
+
+    static inline const char *csvHeader() noexcept
+    {
+        return "time_stamp,frames,stage,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns";
+    }
+
+private:
+    std::array<LatencyHistogram, NUMBER_OF_STAGES> m_histograms{};
+    std::chrono::steady_clock::time_point m_last{};
+    std::chrono::steady_clock::time_point m_frameBegin{};
+    uint64_t m_frameNanoseconds{0};
+    uint64_t m_frames{0};
+};
+
+/**
+ * @return Flag raised asynchronously by SIGUSR1 to request a dump of the stage timings.
+ */
+inline volatile std::sig_atomic_t &stageTimingsDumpRequested() noexcept
+{
+    static volatile std::sig_atomic_t requested = 0;
+    return requested;
+}
+
+inline void onStageTimingsDumpSignal(int /*signal*/) noexcept
+{
+    stageTimingsDumpRequested() = 1;
+}
+
+/**
+ * Print the summary to std::clog and append the CSV lines to the given file.
+ */
+inline void dumpStageTimings(const StageTimings &timings, const std::string &fileName, int64_t timeStamp)
+{
+    timings.printSummary(std::clog);
+
+    std::ifstream existing(fileName);
+    const bool writeHeader = !existing.good();
+    existing.close();
+
+    std::ofstream file(fileName, std::ios::app);
+    if (writeHeader)
+    {
+        file << StageTimings::csvHeader() << "\n";
+    }
+    timings.writeCsv(file, timeStamp);
+}
+
+// The instrumentation macros expand to nothing unless the project is
+// configured with -DENABLE_STAGE_TIMING=ON.
+#ifdef ENABLE_STAGE_TIMING
+#define STAGE_TIMING_START(timings) (timings).start()
+#define STAGE_TIMING_LAP(timings, stage) (timings).lap(stage)
+#define STAGE_TIMING_END_FRAME(timings) (timings).endFrame()
+#else
+#define STAGE_TIMING_START(timings) static_cast<void>(0)
+#define STAGE_TIMING_LAP(timings, stage) static_cast<void>(0)
+#define STAGE_TIMING_END_FRAME(timings) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,594 @@
+/*
+ * Copyright (C) 2021  Group 17
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Self-checking tests for the parts of libcluon that this project changed;
+// every failed check is reported and makes the program exit with 1.
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static uint32_t failures{0};
+
+static void check(bool condition, const char *expression, const char *file, int32_t line)
+{
+    if (!condition)
+    {
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+        failures++;
+    }
+}
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+// Waits until the given condition holds or the timeout expires.
+template <typename Condition>
+static bool waitFor(Condition condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000))
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition() && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+// Entries pass the ring buffer many times over and must arrive complete and in order.
+static void testPipelineWrapAround()
+{
+    constexpr uint64_t ENTRIES{100000};
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> outOfOrder{0};
+    cluon::NotifyingPipeline<uint64_t> pipeline(
+        [&](uint64_t &&entry) {
+            if (entry != received.load())
+            {
+                outOfOrder++;
+            }
+            received++;
+        },
+        4);
+    CHECK(4 == pipeline.capacity());
+    for (uint64_t i{0}; i < ENTRIES; i++)
+    {
+        pipeline.add(uint64_t{i});
+        if (0 == (i % 3))
+        {
+            pipeline.notifyAll();
+        }
+    }
+    pipeline.notifyAll();
+    CHECK(waitFor([&]() { return ENTRIES == received.load(); }));
+    CHECK(0 == outOfOrder.load());
+    CHECK(0 == pipeline.numberOfDroppedEntries());
+    CHECK(4 >= pipeline.highWaterMark());
+}
+
+// Every entry added to a pipeline of the given capacity is either delivered in order or discarded.
+static void testPipelineCapacity(size_t capacity, cluon::OverflowPolicy overflowPolicy)
+{
+    constexpr uint64_t ENTRIES{1000};
+    std::mutex deliveredMutex;
+    std::vector<uint64_t> delivered;
+    std::atomic<uint64_t> discarded{0};
+    cluon::NotifyingPipeline<uint64_t> pipeline(
+        [&](uint64_t &&entry) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            std::lock_guard<std::mutex> lck(deliveredMutex);
+            delivered.push_back(entry);
+        },
+        capacity,
+        overflowPolicy,
+        [&](uint64_t &&) { discarded++; });
+
+    size_t expectedCapacity{2};
+    while (expectedCapacity < capacity)
+    {
+        expectedCapacity <<= 1;
+    }
+    CHECK(expectedCapacity == pipeline.capacity());
+
+    for (uint64_t i{0}; i < ENTRIES; i++)
+    {
+        pipeline.add(uint64_t{i});
+        pipeline.notifyAll();
+    }
+    const bool drained{waitFor([&]() {
+        std::lock_guard<std::mutex> lck(deliveredMutex);
+        return ENTRIES == delivered.size() + pipeline.numberOfDroppedEntries();
+    })};
+    CHECK(drained);
+
+    std::lock_guard<std::mutex> lck(deliveredMutex);
+    CHECK(discarded.load() == pipeline.numberOfDroppedEntries());
+    CHECK(pipeline.capacity() >= pipeline.highWaterMark());
+    for (size_t i{1}; i < delivered.size(); i++)
+    {
+        CHECK(delivered[i - 1] < delivered[i]);
+    }
+    if (cluon::OverflowPolicy::BLOCK == overflowPolicy)
+    {
+        CHECK(ENTRIES == delivered.size());
+    }
+    else if (cluon::OverflowPolicy::DROP_OLDEST == overflowPolicy)
+    {
+        CHECK(!delivered.empty() && (ENTRIES - 1 == delivered.back()));
+    }
+    else
+    {
+        CHECK(!delivered.empty() && (0 == delivered.front()));
+    }
+}
+
+static void testPipelineSmallCapacities()
+{
+    for (size_t capacity : std::vector<size_t>{0, 1, 2, 3, 5})
+    {
+        for (auto overflowPolicy : {cluon::OverflowPolicy::BLOCK, cluon::OverflowPolicy::DROP_OLDEST, cluon::OverflowPolicy::DROP_NEWEST})
+        {
+            testPipelineCapacity(capacity, overflowPolicy);
+        }
+    }
+}
+
+// Largest payload of a UDP datagram and the header of a datagram carrying a fragment of an Envelope.
+constexpr std::size_t MAX_DATAGRAM_SIZE{65507};
+constexpr std::size_t FRAGMENT_HEADER_SIZE{14};
+
+// @return OD4-framed Envelope carrying the given message.
+template <typename T>
+static std::string encode(T &message)
+{
+    cluon::ToProtoVisitor protoEncoder;
+    message.accept(protoEncoder);
+
+    cluon::data::Envelope envelope;
+    envelope.dataType(static_cast<int32_t>(T::ID()));
+    envelope.serializedData(protoEncoder.encodedData());
+    envelope.sent(cluon::time::now());
+    envelope.sampleTimeStamp(envelope.sent());
+    return cluon::serializeEnvelope(std::move(envelope));
+}
+
+// @return ImageReading whose data has the given size and depends on the given seed.
+static opendlv::proxy::ImageReading imageReading(std::size_t size, uint32_t seed)
+{
+    std::string data(size, '\0');
+    for (std::size_t i{0}; i < size; i++)
+    {
+        data[i] = static_cast<char>((i * 31 + seed) % 251);
+    }
+    opendlv::proxy::ImageReading message;
+    message.fourcc("test").width(seed).data(data);
+    return message;
+}
+
+// Splits an encoded Envelope into datagrams as OD4Session does: 0x0D 0xA5 followed by the sequence
+// identifier (uint32), the fragment's index and the number of fragments (uint16 each), and the
+// size of the Envelope (uint32), all little endian.
+static std::vector<std::string> fragment(const std::string &envelope, uint32_t sequenceIdentifier)
+{
+    constexpr std::size_t FRAGMENT_SIZE{MAX_DATAGRAM_SIZE - FRAGMENT_HEADER_SIZE};
+    const std::size_t count{(envelope.size() + FRAGMENT_SIZE - 1) / FRAGMENT_SIZE};
+    auto littleEndian = [](uint32_t value, std::size_t bytes) {
+        std::string retVal;
+        for (std::size_t i{0}; i < bytes; i++)
+        {
+            retVal.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+        return retVal;
+    };
+    std::vector<std::string> fragments;
+    for (std::size_t index{0}; index < count; index++)
+    {
+        const std::size_t offset{index * FRAGMENT_SIZE};
+        fragments.push_back(std::string("\x0D\xA5") + littleEndian(sequenceIdentifier, 4) + littleEndian(static_cast<uint32_t>(index), 2)
+                            + littleEndian(static_cast<uint32_t>(count), 2) + littleEndian(static_cast<uint32_t>(envelope.size()), 4)
+                            + envelope.substr(offset, FRAGMENT_SIZE));
+    }
+    return fragments;
+}
+
+// Fragments sent out of order, twice, interleaved with another Envelope's, or not at all must
+// yield each complete Envelope exactly once and no incomplete one.
+static void testFragmentReassembly()
+{
+    constexpr uint16_t CID{243};
+    std::mutex receivedMutex;
+    std::vector<opendlv::proxy::ImageReading> received;
+    cluon::OD4Session od4{CID};
+    od4.reassemblyLimits(64 * 1024 * 1024, std::chrono::milliseconds(200));
+    od4.dataTrigger(opendlv::proxy::ImageReading::ID(), [&](cluon::data::Envelope &&envelope) {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        received.push_back(cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(envelope)));
+    });
+    cluon::UDPSender sender{"225.0.0." + std::to_string(CID), 12175};
+    CHECK(od4.isRunning());
+
+    // A burst of large datagrams could overflow the receive buffer.
+    auto send = [&sender](const std::string &datagram) {
+        sender.send(datagram.data(), datagram.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    };
+
+    auto first  = imageReading(200000, 1);
+    auto second = imageReading(150000, 2);
+    auto third  = imageReading(140000, 3);
+    auto fourth = imageReading(70000, 4);
+    auto fifth  = imageReading(100000, 5);
+    const std::vector<std::string> FIRST{fragment(encode(first), 1)};
+    const std::vector<std::string> SECOND{fragment(encode(second), 2)};
+    const std::vector<std::string> THIRD{fragment(encode(third), 3)};
+    const std::vector<std::string> FOURTH{fragment(encode(fourth), 4)};
+    const std::vector<std::string> FIFTH{fragment(encode(fifth), 5)};
+    CHECK(4 == FIRST.size());
+
+    // Reversed and with a duplicate.
+    for (auto it = FIRST.rbegin(); it != FIRST.rend(); ++it)
+    {
+        send(*it);
+    }
+    send(FIRST[1]);
+    // The second fragment is lost; the Envelope expires.
+    send(SECOND[0]);
+    send(SECOND[2]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    // Interleaved with each other.
+    send(THIRD[2]);
+    send(FOURTH[1]);
+    send(THIRD[0]);
+    send(FOURTH[0]);
+    send(THIRD[1]);
+    // A fragment arriving after the Envelope expired does not start it over.
+    send(SECOND[1]);
+    // A truncated fragment is ignored.
+    send(FIFTH[0].substr(0, 1000));
+    for (const auto &f : FIFTH)
+    {
+        send(f);
+    }
+
+    const bool complete{waitFor([&]() {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        return 4 <= received.size();
+    })};
+    CHECK(complete);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    CHECK(4 == received.size());
+    CHECK(4 == od4.numberOfReassembledEnvelopes());
+    CHECK(1 <= od4.numberOfDroppedReassemblies());
+    std::vector<opendlv::proxy::ImageReading> expected{first, third, fourth, fifth};
+    for (std::size_t i{0}; (i < expected.size()) && (i < received.size()); i++)
+    {
+        // The third and fourth Envelope complete in the order of their last fragments.
+        const std::size_t j{(1 == i) ? 2 : ((2 == i) ? 1 : i)};
+        CHECK(expected[j].width() == received[i].width());
+        CHECK(expected[j].data() == received[i].data());
+    }
+}
+
+// Envelopes are packed back to back into datagrams of at most the given size, split only at
+// Envelope boundaries; larger ones are sent on their own or in fragments.
+static void testPackingSplit()
+{
+    constexpr uint16_t CID{244};
+    constexpr std::size_t PACK{1472};
+    constexpr uint32_t MESSAGES{500};
+    std::mutex receivedMutex;
+    std::vector<uint32_t> steering;
+    std::vector<std::size_t> images;
+    cluon::OD4Session receiver{CID};
+    receiver.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), [&](cluon::data::Envelope &&envelope) {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        steering.push_back(static_cast<uint32_t>(cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(envelope)).groundSteering()));
+    });
+    receiver.dataTrigger(opendlv::proxy::ImageReading::ID(), [&](cluon::data::Envelope &&envelope) {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        images.push_back(cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(envelope)).data().size());
+    });
+
+    // Datagrams as sent, checked for whole Envelopes.
+    std::atomic<uint32_t> packedDatagrams{0};
+    std::atomic<uint32_t> largeDatagrams{0};
+    std::atomic<uint32_t> fragments{0};
+    std::atomic<uint32_t> malformedDatagrams{0};
+    cluon::UDPReceiver datagrams{"225.0.0." + std::to_string(CID), 12175, [&](const cluon::UDPDatagram &datagram) {
+                                     const auto *data = reinterpret_cast<const uint8_t *>(datagram.data());
+                                     if ((2 <= datagram.size()) && (0x0D == data[0]) && (0xA5 == data[1]))
+                                     {
+                                         fragments++;
+                                         return;
+                                     }
+                                     std::size_t envelopes{0};
+                                     std::size_t offset{0};
+                                     while ((offset + 5 <= datagram.size()) && (0x0D == data[offset]) && (0xA4 == data[offset + 1]))
+                                     {
+                                         offset += 5 + (static_cast<std::size_t>(data[offset + 2]) | (static_cast<std::size_t>(data[offset + 3]) << 8)
+                                                        | (static_cast<std::size_t>(data[offset + 4]) << 16));
+                                         envelopes++;
+                                     }
+                                     if ((offset != datagram.size()) || (0 == envelopes))
+                                     {
+                                         malformedDatagrams++;
+                                     }
+                                     else if (PACK < datagram.size())
+                                     {
+                                         largeDatagrams++;
+                                         malformedDatagrams += (1 == envelopes) ? 0 : 1;
+                                     }
+                                     else
+                                     {
+                                         packedDatagrams++;
+                                     }
+                                 }};
+
+    cluon::OD4Session sender{CID};
+    sender.batchSends(true, false);
+    sender.packEnvelopes(PACK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (uint32_t i{0}; i < MESSAGES; i++)
+    {
+        opendlv::proxy::GroundSteeringRequest request;
+        request.groundSteering(static_cast<float>(i));
+        sender.send(request);
+        if (MESSAGES / 2 == i)
+        {
+            // Between the packing limit and the datagram limit, and beyond the datagram limit.
+            auto large = imageReading(PACK + 100, 6);
+            sender.send(large);
+            auto fragmented = imageReading(MAX_DATAGRAM_SIZE + 100, 7);
+            sender.send(fragmented);
+        }
+        if (0 == (i % 50))
+        {
+            sender.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    sender.flush();
+    CHECK(MESSAGES + 2 == sender.numberOfSentEnvelopes());
+
+    const bool complete{waitFor([&]() {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        return (MESSAGES == steering.size()) && (2 == images.size());
+    })};
+    CHECK(complete);
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    for (std::size_t i{0}; i < steering.size(); i++)
+    {
+        CHECK(i == steering[i]);
+    }
+    CHECK(0 == malformedDatagrams.load());
+    CHECK(1 == largeDatagrams.load());
+    CHECK(2 == fragments.load());
+    // Packing sends far fewer datagrams than Envelopes.
+    CHECK((0 < packedDatagrams.load()) && (MESSAGES / 10 > packedDatagrams.load()));
+}
+
+// The OD4 header stores an Envelope's length in 24 bits; larger Envelopes must not be sent.
+static void testOversizedEnvelope()
+{
+    constexpr uint16_t CID{244};
+    std::atomic<uint32_t> received{0};
+    cluon::OD4Session receiver{CID, [&](cluon::data::Envelope &&) { received++; }};
+    cluon::OD4Session sender{CID};
+    auto oversized = imageReading(16 * 1024 * 1024, 8);
+    sender.send(oversized);
+    CHECK(0 == sender.numberOfSentEnvelopes());
+    auto small = imageReading(100, 9);
+    sender.send(small);
+    CHECK(1 == sender.numberOfSentEnvelopes());
+    const bool delivered{waitFor([&]() { return 1 == received.load(); })};
+    CHECK(delivered);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK(1 == received.load());
+}
+
+#ifdef __linux__
+static struct sockaddr_in localSender(uint16_t port)
+{
+    struct sockaddr_in sender
+    {
+    };
+    sender.sin_family      = AF_INET;
+    sender.sin_port        = htons(port);
+    sender.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return sender;
+}
+
+static bool sharedMemoryExists(uint16_t cid)
+{
+    struct stat status
+    {
+    };
+    return 0 == ::stat(("/dev/shm/cluon-od4-" + std::to_string(cid)).c_str(), &status);
+}
+
+// Datagrams reach the other attached peers but not the sender; detaching peers release their
+// slots and the last one removes the shared memory.
+static void testLocalTransportAttachDetach()
+{
+    constexpr uint16_t CID{245};
+    ::shm_unlink(("/cluon-od4-" + std::to_string(CID)).c_str());
+
+    std::atomic<uint32_t> receivedByFirst{0};
+    std::atomic<uint32_t> receivedBySecond{0};
+    std::atomic<uint32_t> senderOfSecond{0};
+    auto first = std::make_unique<cluon::LocalTransport>(
+        CID, 40001, [&](const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point) { receivedByFirst++; });
+    auto second = std::make_unique<cluon::LocalTransport>(
+        CID, 40002, [&](const char *data, std::size_t size, uint16_t sendFromPort, std::chrono::system_clock::time_point) {
+            if (std::string("hello") == std::string(data, size))
+            {
+                senderOfSecond.store(sendFromPort);
+                receivedBySecond++;
+            }
+        });
+    CHECK(first->isRunning());
+    CHECK(second->isRunning());
+    CHECK(sharedMemoryExists(CID));
+
+    CHECK(first->send("hello", 5));
+    const bool received{waitFor([&]() { return 1 == receivedBySecond.load(); })};
+    CHECK(received);
+    CHECK(40001 == senderOfSecond.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(0 == receivedByFirst.load());
+    CHECK(1 == first->numberOfReceivedDatagrams() + second->numberOfReceivedDatagrams());
+
+    CHECK(second->isAttachedSender(localSender(40001)));
+    CHECK(first->isAttachedSender(localSender(40002)));
+    CHECK(!second->isAttachedSender(localSender(40009)));
+
+    first.reset();
+    CHECK(!second->isAttachedSender(localSender(40001)));
+    CHECK(sharedMemoryExists(CID));
+    second.reset();
+    CHECK(!sharedMemoryExists(CID));
+}
+
+// A stopped process stays attached; once it died without detaching, its slot must neither be taken
+// for attached nor keep the shared memory alive, and UDP datagrams from its port must not be filtered.
+static void testLocalTransportStaleOwner()
+{
+    constexpr uint16_t CID{246};
+    ::shm_unlink(("/cluon-od4-" + std::to_string(CID)).c_str());
+
+    std::array<int, 2> ready{};
+    CHECK(0 == ::pipe(ready.data()));
+    const pid_t child{::fork()};
+    if (0 == child)
+    {
+        cluon::LocalTransport stale(CID, 40003, [](const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point) {});
+        const char c{stale.isRunning() ? '1' : '0'};
+        (void)!::write(ready[1], &c, 1);
+        while (true)
+        {
+            ::pause();
+        }
+    }
+    char c{0};
+    CHECK((1 == ::read(ready[0], &c, 1)) && ('1' == c));
+    ::close(ready[0]);
+    ::close(ready[1]);
+
+    std::atomic<uint32_t> received{0};
+    auto survivor = std::make_unique<cluon::LocalTransport>(
+        CID, 40004, [&](const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point) { received++; });
+    CHECK(survivor->isRunning());
+    ::kill(child, SIGSTOP);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(survivor->isAttachedSender(localSender(40003)));
+
+    ::kill(child, SIGKILL);
+    int32_t status{0};
+    CHECK((child == ::waitpid(child, &status, 0)) && WIFSIGNALED(status));
+    CHECK(!survivor->isAttachedSender(localSender(40003)));
+
+    {
+        cluon::LocalTransport observer(CID, 40005, [](const char *, std::size_t, uint16_t, std::chrono::system_clock::time_point) {});
+        CHECK(observer.isAttachedSender(localSender(40004)));
+        CHECK(!observer.isAttachedSender(localSender(40003)));
+        CHECK(observer.send("hello", 5));
+        const bool delivered{waitFor([&]() { return 1 == received.load(); })};
+        CHECK(delivered);
+    }
+    CHECK(sharedMemoryExists(CID));
+    survivor.reset();
+    CHECK(!sharedMemoryExists(CID));
+}
+
+// A slow delegate must not make its session lose frames that are sent back to back and exceed
+// the shared memory's capacity together.
+static void testLocalTransportSlowConsumer()
+{
+    constexpr uint16_t CID{247};
+    ::shm_unlink(("/cluon-od4-" + std::to_string(CID)).c_str());
+
+    std::atomic<uint32_t> received{0};
+    std::atomic<uint32_t> intact{0};
+    cluon::OD4Session receiver{CID};
+    receiver.dataTrigger(opendlv::proxy::ImageReading::ID(), [&](cluon::data::Envelope &&envelope) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto FRAME = cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(envelope));
+        const std::size_t SIZE{((8 > FRAME.width()) ? 1u : 6u) * 1024u * 1024u};
+        if (imageReading(SIZE, FRAME.width()).data() == FRAME.data())
+        {
+            intact++;
+        }
+        received++;
+    });
+    cluon::OD4Session sender{CID};
+    for (uint32_t i{0}; i < 8; i++)
+    {
+        auto frame = imageReading(1024 * 1024, i);
+        sender.send(frame);
+    }
+    for (uint32_t i{0}; i < 3; i++)
+    {
+        auto frame = imageReading(6 * 1024 * 1024, 8 + i);
+        sender.send(frame);
+    }
+    const bool delivered{waitFor([&]() { return 11 == received.load(); }, std::chrono::milliseconds(10000))};
+    CHECK(delivered);
+    CHECK(11 == intact.load());
+    CHECK(0 == receiver.numberOfSharedMemoryOverruns());
+}
+#endif
+
+int32_t main(int32_t, char **)
+{
+    testPipelineWrapAround();
+    testPipelineSmallCapacities();
+    testFragmentReassembly();
+    testPackingSplit();
+    testOversizedEnvelope();
+#ifdef __linux__
+    testLocalTransportAttachDetach();
+    testLocalTransportStaleOwner();
+    testLocalTransportSlowConsumer();
+#endif
+
+    if (0 < failures)
+    {
+        std::cerr << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed." << std::endl;
+    return 0;
+}